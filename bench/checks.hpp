@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+// Optimized paths checked against their references before anything is measured, each returns how many results differ.
+std::size_t countPacketRaycastMismatches();
+
+// Compares with known visibility maps and checks that every air cell in range sees the viewer exactly when the viewer sees it.
+std::size_t countFieldOfViewMismatches();
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <vkx/vkx.hpp>
+
+struct Position {
+	glm::vec2 value{0};
+};
+
+struct Velocity {
+	glm::vec2 value{0};
+};
+
+struct Lifetime {
+	float seconds = 0.0f;
+};
+
+// Particles spread over two archetypes, a third of them fading out.
+static vkx::World createParticles(std::size_t count) {
+	vkx::World world{};
+	for (std::size_t i = 0; i < count; i++) {
+		const auto angle = static_cast<float>(i) * 2.3999632f;
+		const Velocity velocity{glm::vec2{std::cos(angle), std::sin(angle)}};
+		if (i % 3 == 0) {
+			world.create(Position{}, velocity, Lifetime{static_cast<float>(i % 60)});
+		} else {
+			world.create(Position{}, velocity);
+		}
+	}
+
+	return world;
+}
+
+static void ecsEach(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto world = createParticles(count);
+
+	for (auto _ : state) {
+		world.each<Position, Velocity>([](Position& position, const Velocity& velocity) {
+			position.value += velocity.value;
+		});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(ecsEach)->ArgName("entities")->Arg(10000)->Arg(100000);
+
+static void ecsParallelEach(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto world = createParticles(count);
+	vkx::ThreadPool pool{0};
+
+	for (auto _ : state) {
+		world.parallelEach<Position, Velocity>(pool, [](Position& position, const Velocity& velocity) {
+			position.value += velocity.value;
+		});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(ecsParallelEach)->ArgName("entities")->Arg(10000)->Arg(100000)->UseRealTime();
+
+// Moving, ageing and counting particles, the first two run side by side.
+static void ecsScheduler(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto world = createParticles(count);
+	vkx::ThreadPool pool{0};
+
+	vkx::SystemScheduler scheduler{};
+	scheduler.add("move", vkx::componentMask<Velocity>(), vkx::componentMask<Position>(), [](vkx::World& world) {
+		world.each<Position, Velocity>([](Position& position, const Velocity& velocity) {
+			position.value += velocity.value;
+		});
+	});
+	scheduler.add("age", 0, vkx::componentMask<Lifetime>(), [](vkx::World& world) {
+		world.each<Lifetime>([](Lifetime& lifetime) {
+			lifetime.seconds -= 1.0f / 60.0f;
+		});
+	});
+	scheduler.add("bounds", vkx::componentMask<Position>(), 0, [](vkx::World& world) {
+		glm::vec2 max{0};
+		world.each<Position>([&max](const Position& position) {
+			max = glm::max(max, glm::abs(position.value));
+		});
+		benchmark::DoNotOptimize(max);
+	});
+
+	for (auto _ : state) {
+		scheduler.run(world, pool);
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(ecsScheduler)->ArgName("entities")->Arg(10000)->Arg(100000)->UseRealTime();
+
+// Adding and removing a component moves the entity between archetypes.
+static void ecsAddRemove(benchmark::State& state) {
+	auto world = createParticles(10000);
+	const auto entity = world.create(Position{}, Velocity{});
+
+	for (auto _ : state) {
+		world.add(entity, Lifetime{1.0f});
+		world.remove<Lifetime>(entity);
+	}
+}
+BENCHMARK(ecsAddRemove);
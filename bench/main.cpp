@@ -0,0 +1,29 @@
+#include "checks.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+	// Timings of a path that gives wrong results mean nothing, so the run fails before measuring anything.
+	const auto packetMismatches = countPacketRaycastMismatches();
+	if (packetMismatches != 0) {
+		std::fprintf(stderr, "%zu packet raycasts differ from scalar raycasts\n", packetMismatches);
+		return EXIT_FAILURE;
+	}
+
+	const auto fieldOfViewMismatches = countFieldOfViewMismatches();
+	if (fieldOfViewMismatches != 0) {
+		std::fprintf(stderr, "%zu cells differ from the known visibility maps or are not symmetric\n", fieldOfViewMismatches);
+		return EXIT_FAILURE;
+	}
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return EXIT_FAILURE;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return EXIT_SUCCESS;
+}
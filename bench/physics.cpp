@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <vkx/vkx.hpp>
+
+// Bodies wandering over terrain chunks, spread out so a few percent of them overlap at any time.
+static void physicsStep(benchmark::State& state) {
+	const auto bodyCount = static_cast<std::size_t>(state.range(0));
+	vkx::ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+
+	const vkx::ChunkWindow window{2, glm::ivec2{0, 0}};
+	std::vector<vkx::VoxelChunk2D> chunks{};
+	for (std::size_t i = 0; i < window.size(); i++) {
+		chunks.emplace_back(glm::vec2{window.coordinate(i)}).generateTerrain();
+	}
+
+	const auto lookup = [&window, &chunks](const glm::ivec2& chunk) -> const vkx::VoxelChunk2D* {
+		return window.contains(chunk) ? &chunks[window.slot(chunk)] : nullptr;
+	};
+
+	vkx::PhysicsWorld world{2.0f};
+	for (std::size_t i = 0; i < bodyCount; i++) {
+		// Golden angle spiral, deterministic and evenly spread.
+		const auto angle = static_cast<float>(i) * 2.3999632f;
+		const auto distance = std::sqrt(static_cast<float>(i) / static_cast<float>(bodyCount)) * 72.0f;
+		world.add(vkx::Body{glm::vec2{std::cos(angle), std::sin(angle)} * distance, glm::vec2{0.8f, 0.8f}, glm::vec2{std::sin(angle), std::cos(angle)} * 0.25f});
+	}
+
+	for (auto _ : state) {
+		world.step(lookup, pool);
+		benchmark::DoNotOptimize(world.getContacts().data());
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bodyCount));
+}
+BENCHMARK(physicsStep)->ArgNames({"bodies", "threads"})->ArgsProduct({{1000, 4000}, {1, 0}})->UseRealTime();
@@ -0,0 +1,228 @@
+#include "checks.hpp"
+#include <benchmark/benchmark.h>
+#include <vkx/vkx.hpp>
+
+// Rays never hit anything, so every benchmark walks its full length.
+static void raycast(benchmark::State& state) {
+	const auto maxLength = static_cast<float>(state.range(0));
+	const glm::vec3 origin{0.5f, 0.5f, 0.5f};
+	const auto direction = glm::normalize(glm::vec3{1.0f, 0.7f, 0.3f});
+
+	for (auto _ : state) {
+		const auto result = vkx::raycast(origin, direction, maxLength, [](const glm::ivec3& position) {
+			return position.x > 1 << 20;
+		});
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(raycast)->ArgName("length")->RangeMultiplier(4)->Range(4, 256);
+
+static void raycast2D(benchmark::State& state) {
+	const auto maxLength = static_cast<float>(state.range(0));
+	const glm::vec2 origin{0.5f, 0.5f};
+	const auto direction = glm::normalize(glm::vec2{1.0f, 0.7f});
+
+	vkx::VoxelChunk2D chunk{glm::vec2{0, 0}};
+
+	for (auto _ : state) {
+		const auto result = vkx::raycast2D(origin, direction, maxLength, [&chunk](const glm::vec2& position) {
+			return chunk.at(static_cast<std::size_t>(position.x), static_cast<std::size_t>(position.y)) != vkx::Voxel::Air;
+		});
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(raycast2D)->ArgName("length")->RangeMultiplier(4)->Range(4, 256);
+
+// A sparse world where only the far column of chunks has terrain, the ray crosses empty chunks and rows until it gets there.
+static void raycastWorld(benchmark::State& state) {
+	const auto maxLength = static_cast<float>(state.range(0));
+	const glm::vec2 origin{0.5f, 0.5f};
+	const auto direction = glm::normalize(glm::vec2{1.0f, 0.1f});
+
+	const vkx::ChunkWindow window{4, glm::ivec2{0, 0}};
+	std::vector<vkx::VoxelChunk2D> chunks{};
+	for (std::size_t i = 0; i < window.size(); i++) {
+		auto& chunk = chunks.emplace_back(glm::vec2{window.coordinate(i)});
+		if (window.coordinate(i).x == window.getRadius()) {
+			chunk.generateTestBox();
+		}
+	}
+
+	const auto lookup = [&window, &chunks](const glm::ivec2& chunk) -> const vkx::VoxelChunk2D* {
+		return window.contains(chunk) ? &chunks[window.slot(chunk)] : nullptr;
+	};
+
+	for (auto _ : state) {
+		const auto result = vkx::raycastWorld(origin, direction, maxLength, lookup, [](vkx::Voxel, const glm::ivec2&) { return true; });
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(raycastWorld)->ArgName("length")->RangeMultiplier(4)->Range(4, 256);
+
+// Rays fanned out from the middle of a grid of terrain chunks, like line of sight or light probe queries.
+struct RayBatch {
+	static constexpr std::size_t COUNT = 256;
+
+	vkx::OccupancyGrid grid{glm::ivec2{-2, -2}, 4, 4};
+	std::vector<glm::vec2> origins{};
+	std::vector<glm::vec2> directions{};
+	std::vector<vkx::Raycast2DResult> results{COUNT};
+
+	RayBatch() {
+		for (std::int32_t y = -2; y < 2; y++) {
+			for (std::int32_t x = -2; x < 2; x++) {
+				vkx::VoxelChunk2D chunk{glm::vec2{x, y}};
+				chunk.generateTerrain();
+				grid.copyChunk(glm::ivec2{x, y}, chunk);
+			}
+		}
+
+		// Golden angle steps spread the directions evenly without repeating.
+		for (std::size_t i = 0; i < COUNT; i++) {
+			const auto angle = static_cast<float>(i) * 2.3999632f;
+			origins.emplace_back(static_cast<float>(i % 16) - 7.5f, static_cast<float>(i / 16) - 7.5f);
+			directions.emplace_back(std::cos(angle), std::sin(angle));
+		}
+	}
+};
+
+static void raycastBatchScalar(benchmark::State& state) {
+	const auto maxLength = static_cast<float>(state.range(0));
+	RayBatch batch{};
+
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < RayBatch::COUNT; i++) {
+			batch.results[i] = vkx::raycast2D(batch.origins[i], batch.directions[i], maxLength, [&batch](const glm::vec2& position) {
+				return batch.grid.isSolid(glm::ivec2{position});
+			});
+		}
+		benchmark::DoNotOptimize(batch.results.data());
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * RayBatch::COUNT));
+}
+BENCHMARK(raycastBatchScalar)->ArgName("length")->RangeMultiplier(4)->Range(16, 64);
+
+#if defined(VKX_SIMD_SSE2) || defined(VKX_SIMD_AVX2)
+// Rays the packet cast has to answer exactly like the scalar one: random rays, diagonals starting on cell corners
+// and centers where both axes are crossed at the same length, and rays along each axis.
+struct PacketCheckRays {
+	static constexpr std::size_t COUNT = 1024;
+
+	std::vector<glm::vec2> origins{};
+	std::vector<glm::vec2> directions{};
+
+	PacketCheckRays() {
+		// Xorshift keeps the rays the same on every run.
+		std::uint32_t seed = 0x9e3779b9;
+		const auto random = [&seed](float minimum, float maximum) {
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			return minimum + (maximum - minimum) * static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+		};
+
+		constexpr std::array axes{glm::vec2{1.0f, 0.0f}, glm::vec2{-1.0f, 0.0f}, glm::vec2{0.0f, 1.0f}, glm::vec2{0.0f, -1.0f}};
+		const auto diagonal = glm::normalize(glm::vec2{1.0f, 1.0f});
+
+		for (std::size_t i = 0; i < COUNT; i++) {
+			glm::vec2 origin{random(-60.0f, 60.0f), random(-60.0f, 60.0f)};
+			glm::vec2 direction{};
+			switch (i % 4) {
+			case 0:
+				direction = glm::normalize(glm::vec2{random(-1.0f, 1.0f), random(-1.0f, 1.0f)} + 0.001f);
+				break;
+			case 1:
+				origin = glm::floor(origin) + (i % 8 == 1 ? 0.0f : 0.5f);
+				direction = diagonal * glm::vec2{i % 16 < 8 ? 1.0f : -1.0f, i % 32 < 16 ? 1.0f : -1.0f};
+				break;
+			case 2:
+				direction = axes[(i / 4) % axes.size()];
+				break;
+			default:
+				origin = glm::floor(origin);
+				direction = axes[(i / 4) % axes.size()];
+				break;
+			}
+
+			origins.push_back(origin);
+			directions.push_back(direction);
+		}
+	}
+};
+
+// Returns how many rays the packet cast answers differently from the scalar one.
+template <class Lanes>
+static std::size_t countPacketMismatches(const glm::vec2* origins, const glm::vec2* directions, std::size_t count, float maxLength, const vkx::OccupancyGrid& grid) {
+	std::vector<vkx::Raycast2DResult> results(count);
+	std::size_t mismatches = 0;
+	for (std::size_t i = 0; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+		vkx::raycastPacket2D<Lanes>(origins + i, directions + i, maxLength, grid, &results[i]);
+
+		for (std::size_t lane = i; lane < i + Lanes::WIDTH; lane++) {
+			const auto expected = vkx::raycast2D(origins[lane], directions[lane], maxLength, [&grid](const glm::vec2& position) {
+				return grid.isSolid(glm::ivec2{position});
+			});
+
+			const auto& actual = results[lane];
+			if (actual.success != expected.success || actual.length != expected.length || actual.hitPosition != expected.hitPosition || actual.previousHitPosition != expected.previousHitPosition) {
+				mismatches++;
+			}
+		}
+	}
+
+	return mismatches;
+}
+
+template <class Lanes>
+static std::size_t countPacketMismatches(const PacketCheckRays& rays, const RayBatch& batch) {
+	std::size_t mismatches = 0;
+	for (const auto maxLength : {4.0f, 64.0f}) {
+		mismatches += countPacketMismatches<Lanes>(rays.origins.data(), rays.directions.data(), PacketCheckRays::COUNT, maxLength, batch.grid);
+		mismatches += countPacketMismatches<Lanes>(batch.origins.data(), batch.directions.data(), RayBatch::COUNT, maxLength, batch.grid);
+	}
+
+	return mismatches;
+}
+
+template <class Lanes>
+static void raycastBatchPacket(benchmark::State& state) {
+	const auto maxLength = static_cast<float>(state.range(0));
+	RayBatch batch{};
+
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < RayBatch::COUNT; i += Lanes::WIDTH) {
+			vkx::raycastPacket2D<Lanes>(&batch.origins[i], &batch.directions[i], maxLength, batch.grid, &batch.results[i]);
+		}
+		benchmark::DoNotOptimize(batch.results.data());
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * RayBatch::COUNT));
+}
+#endif
+
+#if defined(VKX_SIMD_SSE2)
+BENCHMARK_TEMPLATE(raycastBatchPacket, vkx::simd::Float4)->ArgName("length")->RangeMultiplier(4)->Range(16, 64);
+#endif
+
+#if defined(VKX_SIMD_AVX2)
+BENCHMARK_TEMPLATE(raycastBatchPacket, vkx::simd::Float8)->ArgName("length")->RangeMultiplier(4)->Range(16, 64);
+#endif
+
+std::size_t countPacketRaycastMismatches() {
+	std::size_t mismatches = 0;
+#if defined(VKX_SIMD_SSE2) || defined(VKX_SIMD_AVX2)
+	const RayBatch batch{};
+	const PacketCheckRays rays{};
+#endif
+
+#if defined(VKX_SIMD_SSE2)
+	mismatches += countPacketMismatches<vkx::simd::Float4>(rays, batch);
+#endif
+
+#if defined(VKX_SIMD_AVX2)
+	mismatches += countPacketMismatches<vkx::simd::Float8>(rays, batch);
+#endif
+
+	return mismatches;
+}
@@ -0,0 +1,474 @@
+#include "checks.hpp"
+#include <benchmark/benchmark.h>
+#include <vkx/vkx.hpp>
+
+static constexpr std::size_t MAX_VERTICES = vkx::VoxelChunk2D::MAX_VERTICES;
+static constexpr std::size_t MAX_INDICES = vkx::VoxelChunk2D::MAX_INDICES;
+
+enum class ChunkInput : std::int64_t {
+	Terrain,
+	TestBox,
+	Checkerboard,
+	Empty,
+	Solid
+};
+
+static vkx::VoxelChunk2D createChunk(ChunkInput input) {
+	vkx::VoxelChunk2D chunk{glm::vec2{3, 7}};
+
+	switch (input) {
+	case ChunkInput::Terrain:
+		chunk.generateTerrain();
+		break;
+	case ChunkInput::TestBox:
+		chunk.generateTestBox();
+		break;
+	case ChunkInput::Checkerboard:
+		for (std::size_t y = 0; y < vkx::CHUNK_SIZE; y++) {
+			for (std::size_t x = 0; x < vkx::CHUNK_SIZE; x++) {
+				chunk.set(x, y, (x + y) % 2 == 0 ? vkx::Voxel::Stone : vkx::Voxel::Air);
+			}
+		}
+		break;
+	case ChunkInput::Empty:
+		break;
+	case ChunkInput::Solid:
+		chunk.uniformVoxel = vkx::Voxel::Stone;
+		chunk.updateOccupancy();
+		break;
+	}
+
+	return chunk;
+}
+
+static void generateTerrain(benchmark::State& state) {
+	vkx::VoxelChunk2D chunk{glm::vec2{0, 0}};
+
+	for (auto _ : state) {
+		chunk.generateTerrain();
+		benchmark::DoNotOptimize(chunk.voxels.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(vkx::CHUNK_SIZE * vkx::CHUNK_SIZE));
+}
+BENCHMARK(generateTerrain);
+
+static void generateMesh(benchmark::State& state) {
+	auto chunk = createChunk(static_cast<ChunkInput>(state.range(0)));
+
+	std::vector<vkx::Vertex> vertices(MAX_VERTICES);
+	std::vector<std::uint32_t> indices(MAX_INDICES);
+
+	std::size_t indexCount = 0;
+	for (auto _ : state) {
+		indexCount = chunk.generateQuads(vertices, indices);
+		benchmark::DoNotOptimize(indexCount);
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["quads"] = static_cast<double>(indexCount / 6);
+}
+BENCHMARK(generateMesh)
+    ->ArgName("input")
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Terrain))
+    ->Arg(static_cast<std::int64_t>(ChunkInput::TestBox))
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Checkerboard))
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Empty))
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Solid));
+
+// One voxel changes per remesh, compare with generateMesh which remeshes the whole chunk.
+static void remeshEdit(benchmark::State& state) {
+	auto chunk = createChunk(static_cast<ChunkInput>(state.range(0)));
+
+	// Never resident, so only the meshing is measured.
+	vkx::Mesh mesh{};
+	mesh.vertices.resize(MAX_VERTICES);
+	mesh.indices.resize(MAX_INDICES);
+	chunk.generateQuads(mesh.vertices, mesh.indices);
+
+	std::size_t edit = 0;
+	for (auto _ : state) {
+		const auto i = (edit * 37) % vkx::VoxelChunk2D::VOLUME;
+		const auto x = i % vkx::CHUNK_SIZE;
+		const auto y = i / vkx::CHUNK_SIZE;
+		chunk.set(x, y, chunk.at(x, y) == vkx::Voxel::Air ? vkx::Voxel::Stone : vkx::Voxel::Air);
+		chunk.remesh(mesh);
+		benchmark::DoNotOptimize(mesh.indices.data());
+		benchmark::ClobberMemory();
+		edit++;
+	}
+
+	state.counters["quads"] = static_cast<double>(mesh.activeIndexCount / 6);
+}
+BENCHMARK(remeshEdit)
+    ->ArgName("input")
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Terrain))
+    ->Arg(static_cast<std::int64_t>(ChunkInput::Checkerboard));
+
+static void chunkRingUpdate(benchmark::State& state) {
+	vkx::ChunkWindow window{static_cast<std::int32_t>(state.range(0)), glm::ivec2{0, 0}};
+	std::vector<std::size_t> changed{};
+
+	// The player walks diagonally, so chunks keep crossing the window boundary.
+	constexpr glm::vec2 velocity{1.0f, 1.0f};
+	glm::vec2 player{0, 0};
+	std::size_t relocated = 0;
+	for (auto _ : state) {
+		player += velocity;
+
+		window.move(player, velocity, changed);
+		relocated += changed.size();
+
+		benchmark::DoNotOptimize(changed.data());
+	}
+
+	state.counters["relocated"] = benchmark::Counter(static_cast<double>(relocated), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(chunkRingUpdate)->ArgName("radius")->Arg(2)->Arg(8);
+
+static constexpr std::int32_t VISIBILITY_MAP_RADIUS = 9;
+static constexpr std::size_t VISIBILITY_MAP_SIZE = 2 * VISIBILITY_MAP_RADIUS + 1;
+
+// What the viewer '@' in the center sees within VISIBILITY_MAP_RADIUS, worked out with the reference implementation
+// of symmetric shadowcasting. '#' and 'x' are walls, '.' and ' ' are air, '#' and '.' are visible and 'x' and ' ' are not.
+struct VisibilityMap {
+	const char* name;
+	std::array<const char*, VISIBILITY_MAP_SIZE> rows;
+};
+
+static constexpr std::array VISIBILITY_MAPS{
+    VisibilityMap{"pillars",
+		  {"xxxxxxxxx#xxxxxxxxx",
+		   "x      .......    x",
+		   "x       ......    x",
+		   "x  .    ...... .  x",
+		   "x ...#  .....#... x",
+		   "x...... ..........x",
+		   "x......  .........x",
+		   "x.......#.........x",
+		   "x.................x",
+		   "#........@........#",
+		   "x.................x",
+		   "x..........#......x",
+		   "x........... .....x",
+		   "x............  ...x",
+		   "x ...#.......#  . x",
+		   "x  . .........    x",
+		   "x    .........    x",
+		   "x    .........    x",
+		   "xxxxxxxxx#xxxxxxxxx"}},
+    VisibilityMap{"diagonal",
+		  {"xxxxxxxxx#xxxxxxxxx",
+		   "x    .........    x",
+		   "x     .........   x",
+		   "x     ..........  x",
+		   "x      .......... x",
+		   "x.   x ...........x",
+		   "x...  x ..........x",
+		   "x..... x..........x",
+		   "x.......#.........x",
+		   "#........@........#",
+		   "x.........#.......x",
+		   "x..........x .....x",
+		   "x. #.......    ...x",
+		   "x  .#.......     .x",
+		   "x   .#......      x",
+		   "x  . .#......     x",
+		   "x      ......     x",
+		   "x     ........    x",
+		   "xxxxxxxxx#xxxxxxxxx"}},
+    VisibilityMap{"doorway",
+		  {"xxxxxxxxxxxxxxxxxxx",
+		   "x    .            x",
+		   "x   ..            x",
+		   "x   ...           x",
+		   "x    ..        .. x",
+		   "x     ..      .   x",
+		   "x######.#####.####x",
+		   "x.................x",
+		   "x.................x",
+		   "#........@........#",
+		   "x.................x",
+		   "x.................x",
+		   "x....###..........x",
+		   "x..  x #..........x",
+		   "x    xx#......... x",
+		   "x       ........  x",
+		   "x      ........   x",
+		   "x      .......    x",
+		   "xxxxxxxxx#xxxxxxxxx"}}};
+
+// Terrain around the origin with the viewer standing on the air cell closest to it, or a map with the viewer at the origin.
+struct VisibilityScene {
+	vkx::ChunkWindow window{2, glm::ivec2{0, 0}};
+	std::vector<vkx::VoxelChunk2D> chunks{};
+	glm::ivec2 viewer{0, 0};
+
+	VisibilityScene() {
+		for (std::size_t i = 0; i < window.size(); i++) {
+			chunks.emplace_back(glm::vec2{window.coordinate(i)}).generateTerrain();
+		}
+
+		while (isSolid(viewer)) {
+			viewer.x++;
+		}
+	}
+
+	explicit VisibilityScene(const VisibilityMap& map) {
+		for (std::size_t i = 0; i < window.size(); i++) {
+			chunks.emplace_back(glm::vec2{window.coordinate(i)});
+		}
+
+		for (std::size_t y = 0; y < VISIBILITY_MAP_SIZE; y++) {
+			for (std::size_t x = 0; x < VISIBILITY_MAP_SIZE; x++) {
+				if (map.rows[y][x] == '#' || map.rows[y][x] == 'x') {
+					const auto cell = mapCell(x, y);
+					const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+					const auto local = glm::uvec2{cell - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE)};
+					chunks[window.slot(chunkPosition)].set(local.x, local.y, vkx::Voxel::Stone);
+				}
+			}
+		}
+	}
+
+	[[nodiscard]] glm::ivec2 mapCell(std::size_t x, std::size_t y) const {
+		return viewer + glm::ivec2{static_cast<std::int32_t>(x), static_cast<std::int32_t>(y)} - VISIBILITY_MAP_RADIUS;
+	}
+
+	[[nodiscard]] const vkx::VoxelChunk2D* lookup(const glm::ivec2& chunk) const {
+		return window.contains(chunk) ? &chunks[window.slot(chunk)] : nullptr;
+	}
+
+	[[nodiscard]] bool isSolid(const glm::ivec2& cell) const {
+		const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+		const auto* chunk = lookup(chunkPosition);
+		const auto local = glm::uvec2{cell - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE)};
+		return chunk && chunk->at(local.x, local.y) != vkx::Voxel::Air;
+	}
+};
+
+static void fieldOfView(benchmark::State& state) {
+	const auto radius = static_cast<std::int32_t>(state.range(0));
+	const VisibilityScene scene{};
+	vkx::FieldOfView view{};
+
+	for (auto _ : state) {
+		view.compute(scene.viewer, radius, [&scene](const glm::ivec2& chunk) { return scene.lookup(chunk); });
+		benchmark::DoNotOptimize(view.isVisible(scene.viewer));
+	}
+}
+BENCHMARK(fieldOfView)->ArgName("radius")->Arg(8)->Arg(32);
+
+// Returns the air cells within radius of the viewer that do not see the viewer exactly when the viewer sees them.
+static std::size_t countAsymmetricCells(const VisibilityScene& scene, std::int32_t radius) {
+	const auto lookup = [&scene](const glm::ivec2& chunk) { return scene.lookup(chunk); };
+	vkx::FieldOfView view{};
+	vkx::FieldOfView reverse{};
+	view.compute(scene.viewer, radius, lookup);
+
+	std::size_t asymmetric = 0;
+	for (std::int32_t y = -radius; y <= radius; y++) {
+		for (std::int32_t x = -radius; x <= radius; x++) {
+			const auto cell = scene.viewer + glm::ivec2{x, y};
+			if (x * x + y * y > radius * radius || scene.isSolid(cell)) {
+				continue;
+			}
+
+			reverse.compute(cell, radius, lookup);
+			if (reverse.isVisible(scene.viewer) != view.isVisible(cell)) {
+				asymmetric++;
+			}
+		}
+	}
+
+	return asymmetric;
+}
+
+std::size_t countFieldOfViewMismatches() {
+	std::size_t mismatches = 0;
+	vkx::FieldOfView view{};
+	for (const auto& map : VISIBILITY_MAPS) {
+		const VisibilityScene scene{map};
+		view.compute(scene.viewer, VISIBILITY_MAP_RADIUS, [&scene](const glm::ivec2& chunk) { return scene.lookup(chunk); });
+
+		for (std::size_t y = 0; y < VISIBILITY_MAP_SIZE; y++) {
+			for (std::size_t x = 0; x < VISIBILITY_MAP_SIZE; x++) {
+				const auto expected = map.rows[y][x] == '#' || map.rows[y][x] == '.' || map.rows[y][x] == '@';
+				if (view.isVisible(scene.mapCell(x, y)) != expected) {
+					mismatches++;
+				}
+			}
+		}
+
+		mismatches += countAsymmetricCells(scene, VISIBILITY_MAP_RADIUS);
+	}
+
+	return mismatches + countAsymmetricCells(VisibilityScene{}, 8);
+}
+
+// The same question answered by one ray to every cell on the edge of the radius.
+static void fieldOfViewRays(benchmark::State& state) {
+	const auto radius = static_cast<std::int32_t>(state.range(0));
+	const VisibilityScene scene{};
+	const auto origin = glm::vec2{scene.viewer} + 0.5f;
+
+	for (auto _ : state) {
+		for (std::int32_t i = -radius; i <= radius; i++) {
+			for (const auto& target : {glm::ivec2{i, -radius}, glm::ivec2{i, radius}, glm::ivec2{-radius, i}, glm::ivec2{radius, i}}) {
+				const auto offset = glm::vec2{target};
+				const auto result = vkx::raycastWorld(origin, glm::normalize(offset), glm::length(offset), [&scene](const glm::ivec2& chunk) { return scene.lookup(chunk); }, [](vkx::Voxel, const glm::ivec2&) { return true; });
+				benchmark::DoNotOptimize(result);
+			}
+		}
+	}
+}
+BENCHMARK(fieldOfViewRays)->ArgName("radius")->Arg(8)->Arg(32);
+
+// A blast clears a circle and the next one fills it again, every touched chunk is remeshed once per blast.
+// Arg 1 picks between the region editor and one queued edit per voxel.
+static void blast(benchmark::State& state) {
+	const auto radius = static_cast<std::int32_t>(state.range(0));
+	const auto perVoxel = state.range(1) != 0;
+
+	vkx::ChunkWindow window{2, glm::ivec2{0, 0}};
+	vkx::ChunkScheduler scheduler{window.size()};
+	std::vector<vkx::VoxelChunk2D> chunks{};
+	std::vector<vkx::Mesh> meshes(window.size());
+	for (std::size_t i = 0; i < window.size(); i++) {
+		auto& chunk = chunks.emplace_back(glm::vec2{window.coordinate(i)});
+		chunk.generateTerrain();
+
+		// Never resident, so only the edits and meshing are measured.
+		meshes[i].vertices.resize(MAX_VERTICES);
+		meshes[i].indices.resize(MAX_INDICES);
+		chunk.generateQuads(meshes[i].vertices, meshes[i].indices);
+	}
+
+	vkx::EditQueue edits{};
+	std::vector<std::size_t> touched{};
+	// Centered on a chunk corner, so every blast crosses four chunks.
+	const glm::ivec2 center{0, 0};
+	auto voxel = vkx::Voxel::Air;
+
+	for (auto _ : state) {
+		if (perVoxel) {
+			for (auto y = -radius; y <= radius; y++) {
+				for (auto x = -radius; x <= radius; x++) {
+					if (x * x + y * y <= radius * radius) {
+						edits.push(center + glm::ivec2{x, y}, voxel);
+					}
+				}
+			}
+
+			edits.apply(window, chunks, scheduler, touched);
+		} else {
+			touched.clear();
+			vkx::RegionEditor editor{window, chunks, scheduler, touched};
+			editor.fillCircle(center, radius, voxel);
+		}
+
+		for (const auto slot : touched) {
+			chunks[slot].remesh(meshes[slot]);
+		}
+
+		voxel = voxel == vkx::Voxel::Air ? vkx::Voxel::Stone : vkx::Voxel::Air;
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(blast)->ArgNames({"radius", "perVoxel"})->ArgsProduct({{4, 16, 48}, {0, 1}});
+
+// Chunk dimensions and layouts measured against each other, the world itself uses vkx::VoxelChunk2D.
+using RowMajor16 = vkx::BasicVoxelChunk2D<16, 16>;
+using Morton16 = vkx::BasicVoxelChunk2D<16, 16, vkx::MortonLayout>;
+using RowMajor32 = vkx::BasicVoxelChunk2D<32, 32>;
+using Morton32 = vkx::BasicVoxelChunk2D<32, 32, vkx::MortonLayout>;
+
+// Terrain that always has full storage, so the layout is what gets measured.
+template <class Chunk>
+static Chunk createLayoutChunk() {
+	Chunk chunk{glm::vec2{3, 7}};
+	chunk.generateTerrain();
+	chunk.expand();
+	return chunk;
+}
+
+template <class Chunk>
+static void layoutMesh(benchmark::State& state) {
+	auto chunk = createLayoutChunk<Chunk>();
+
+	std::vector<vkx::Vertex> vertices(Chunk::MAX_VERTICES);
+	std::vector<std::uint32_t> indices(Chunk::MAX_INDICES);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(chunk.generateQuads(vertices, indices));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Chunk::VOLUME));
+}
+BENCHMARK_TEMPLATE(layoutMesh, RowMajor16);
+BENCHMARK_TEMPLATE(layoutMesh, Morton16);
+BENCHMARK_TEMPLATE(layoutMesh, RowMajor32);
+BENCHMARK_TEMPLATE(layoutMesh, Morton32);
+
+// Counts the solid neighbours of every voxel, reading the rows above and below each one.
+template <class Chunk>
+static void layoutNeighbors(benchmark::State& state) {
+	const auto chunk = createLayoutChunk<Chunk>();
+
+	for (auto _ : state) {
+		std::size_t solid = 0;
+		for (std::size_t y = 0; y < Chunk::HEIGHT; y++) {
+			for (std::size_t x = 0; x < Chunk::WIDTH; x++) {
+				// Neighbours past the first row or column wrap around to huge indices, which read as air.
+				solid += chunk.at(x - 1, y) != vkx::Voxel::Air;
+				solid += chunk.at(x + 1, y) != vkx::Voxel::Air;
+				solid += chunk.at(x, y - 1) != vkx::Voxel::Air;
+				solid += chunk.at(x, y + 1) != vkx::Voxel::Air;
+			}
+		}
+
+		benchmark::DoNotOptimize(solid);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Chunk::VOLUME));
+}
+BENCHMARK_TEMPLATE(layoutNeighbors, RowMajor16);
+BENCHMARK_TEMPLATE(layoutNeighbors, Morton16);
+BENCHMARK_TEMPLATE(layoutNeighbors, RowMajor32);
+BENCHMARK_TEMPLATE(layoutNeighbors, Morton32);
+
+// A fan of rays from the chunk's center that look at every voxel they cross.
+template <class Chunk>
+static void layoutRaycast(benchmark::State& state) {
+	constexpr std::size_t RAY_COUNT = 64;
+
+	const auto chunk = createLayoutChunk<Chunk>();
+	const glm::vec2 origin{static_cast<float>(Chunk::WIDTH) / 2.0f + 0.5f, static_cast<float>(Chunk::HEIGHT) / 2.0f + 0.5f};
+	const auto maxLength = static_cast<float>(std::min(Chunk::WIDTH, Chunk::HEIGHT)) / 2.0f - 1.0f;
+
+	std::vector<glm::vec2> directions{};
+	for (std::size_t i = 0; i < RAY_COUNT; i++) {
+		const auto angle = static_cast<float>(i) * glm::two_pi<float>() / static_cast<float>(RAY_COUNT);
+		directions.emplace_back(std::cos(angle), std::sin(angle));
+	}
+
+	// Never hits, so every ray walks its full length.
+	const auto predicate = [&chunk](const glm::vec2& position) {
+		benchmark::DoNotOptimize(chunk.at(static_cast<std::size_t>(position.x), static_cast<std::size_t>(position.y)));
+		return false;
+	};
+
+	for (auto _ : state) {
+		for (const auto& direction : directions) {
+			benchmark::DoNotOptimize(vkx::raycast2D(origin, direction, maxLength, predicate));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(RAY_COUNT));
+}
+BENCHMARK_TEMPLATE(layoutRaycast, RowMajor16);
+BENCHMARK_TEMPLATE(layoutRaycast, Morton16);
+BENCHMARK_TEMPLATE(layoutRaycast, RowMajor32);
+BENCHMARK_TEMPLATE(layoutRaycast, Morton32);
@@ -1,30 +1,209 @@
 #pragma once
 
+#include <vkx/asset_pack.hpp>
+#include <vkx/camera.hpp>
+#include <vkx/replay.hpp>
+#include <vkx/statistics.hpp>
+#include <vkx/triple_buffer.hpp>
 #include <vkx/renderer/renderer.hpp>
 #include <vkx/renderer/swapchain.hpp>
 #include <vkx/renderer/pipeline.hpp>
+#include <vkx/renderer/residency.hpp>
+#include <vkx/renderer/bindless.hpp>
 #include <vkx/renderer/commands.hpp>
 #include <vkx/renderer/texture.hpp>
+#include <vkx/voxels/chunk_scheduler.hpp>
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/edit_queue.hpp>
+#include <vkx/voxels/region_edit.hpp>
+#include <vkx/voxels/voxels.hpp>
 
 namespace vkx {
+struct ApplicationSettings {
+	// Render into offscreen images without a window, e.g. on lavapipe for benchmarking and CI.
+	bool headless = false;
+	// Zero runs until the window is closed.
+	std::uint32_t frameLimit = 0;
+	std::uint32_t width = 640;
+	std::uint32_t height = 480;
+	// Chrome trace written when the run ends, empty disables it. F12 writes one on demand.
+	std::string traceFile{};
+	// Input and camera state of every frame is written here.
+	std::string recordFile{};
+	// Drives the loop from a recording instead of SDL events, the run ends with the recording.
+	std::string replayFile{};
+	// Per frame percentiles are written here as JSON when the run ends.
+	std::string statisticsFile{};
+	// Percentiles of a previous run to compare against, see hasRegressed.
+	std::string baselineFile{};
+	// Relative growth over the baseline that counts as a regression.
+	double regressionThreshold = 0.1;
+	// Frames excluded from the statistics while caches and pipelines warm up.
+	std::uint32_t warmupFrames = 10;
+	// Bytes of device memory above which offscreen chunk meshes are evicted, zero only follows the driver's budget.
+	std::uint64_t memoryCeiling = 0;
+	// Shaders and textures are loaded from this pack, empty looks for vkx.pack next to the executable.
+	// Without a pack they are read from build/ and resources/ relative to the working directory.
+	std::string assetPackFile{};
+	// Sample textures through a descriptor indexing table, ignored when the device lacks it.
+	bool bindless = false;
+	// Simulation ticks per second, movement and chunk updates run at this rate whatever the frame rate.
+	double tickRate = 60.0;
+	// Chunks loaded on each side of the camera's chunk.
+	std::uint32_t chunkRadius = 2;
+	// Time each tick may spend generating, meshing and uploading chunks, the rest waits for later ticks.
+	double chunkBudgetMilliseconds = 1.0;
+};
+
+// Input the render thread hands to the simulation.
+struct InputState {
+	glm::vec2 direction{0};
+	glm::vec2 mousePosition{0};
+	vk::Extent2D extent{};
+	// Replays force the recorded camera position onto the simulation.
+	bool hasPosition = false;
+	glm::vec2 position{0};
+	// Held mouse buttons, breaking removes the highlighted voxel, placing puts stone in front of it
+	// and blasting clears a circle around it every tick.
+	bool breaking = false;
+	bool placing = false;
+	bool blasting = false;
+};
+
+// World state as of one simulation tick, everything the render thread draws comes from here.
+struct FrameSnapshot {
+	std::uint64_t tick = 0;
+	std::chrono::steady_clock::time_point time{};
+	glm::vec2 previousCameraPosition{0};
+	glm::vec2 cameraPosition{0};
+	glm::mat4 highlightMatrix{1.0f};
+	// Visible resident chunk meshes, their buffers are never written while a frame in flight may draw them.
+	std::vector<vkx::MeshHandle> meshes{};
+	// Totals since the start of the run.
+	std::uint64_t chunksGenerated = 0;
+	std::uint64_t bytesUploaded = 0;
+};
+
 class application {
 private:
 	bool isRunning;
+	bool framebufferResized = false;
+	vkx::ApplicationSettings settings;
 	vkx::VulkanInstance instance;
 	vkx::CommandSubmitter commandSubmitter;
+	vkx::GPUProfiler gpuProfiler;
+	vkx::AssetPack assets;
 	vkx::Texture texture;
+	vkx::BindlessTable bindless;
+	// One element per chunk mesh, read by bindless shaders.
+	vkx::Buffer objectBuffer;
+	std::uint32_t objectBufferIndex = 0;
 	// yea there needs to be more obviously but for now
 	vkx::pipeline::GraphicsPipeline pipeline;
+	std::vector<vk::CommandBuffer> drawCommands;
+	std::vector<vk::CommandBuffer> secondaryDrawCommands;
+	std::vector<vkx::SyncObjects> syncObjects;
+	vkx::ChunkWindow chunkWindow;
+	vkx::ChunkScheduler chunkScheduler;
+	// Indexed by window slot, like meshes.
+	std::vector<vkx::VoxelChunk2D> chunks;
+	std::vector<vkx::Mesh> meshes;
+	vkx::ResidencyManager residency;
+	// Owned by the render thread, its position is interpolated from snapshots.
+	vkx::Camera2D camera{glm::vec2{0, 0}, glm::vec2{0, 0}, glm::vec2{0.5f, 0.5f}};
+	glm::vec2 direction{0};
+	glm::mat4 projection{1.0f};
+	vkx::InputState input{};
+	vkx::TripleBuffer<vkx::InputState> inputs;
+	// Held while input is published or acquired, so every tick is counted towards the input it ran on.
+	std::mutex inputMutex;
+	std::uint32_t ticksOnInput = 0;
+	vkx::TripleBuffer<vkx::FrameSnapshot> snapshots;
+	// Replays and headless runs tick on the render thread so they stay reproducible, replays as often per frame as recorded.
+	bool lockstep = false;
+	std::uint32_t lockstepTicks = 1;
+	std::thread simulationThread;
+	std::atomic<bool> simulating{false};
+	std::exception_ptr simulationError{};
+	// Snapshot tick drawn by each frame in flight, older evicted buffers can be released.
+	std::array<std::uint64_t, vkx::MAX_FRAMES_IN_FLIGHT> frameTicks{};
+	std::atomic<std::uint64_t> oldestTickInUse{0};
+	// Simulation state, only touched by tick.
+	glm::vec2 cameraPosition{0};
+	glm::vec2 previousCameraPosition{0};
+	glm::vec2 highlightMousePosition{-1.0f};
+	glm::mat4 highlightMatrix{1.0f};
+	// The highlighted voxel and the empty voxel the ray passed before it.
+	bool hasHighlight = false;
+	glm::ivec2 highlightVoxel{0};
+	glm::ivec2 highlightFront{0};
+	vkx::EditQueue edits;
+	std::vector<std::size_t> visibleChunks;
+	std::vector<std::size_t> changedChunks;
+	std::vector<std::size_t> editedChunks;
+	std::uint64_t chunksGenerated = 0;
+	std::uint64_t bytesUploaded = 0;
+	// Snapshot totals already counted in a frame sample.
+	std::uint64_t reportedChunks = 0;
+	std::uint64_t reportedBytes = 0;
+	vkx::InputRecorder recorder;
+	vkx::InputReplayer replayer;
+	vkx::FrameStatistics statistics;
+	vkx::FrameSample frameSample{};
+	std::size_t gpuSamplesResolved = 0;
+	bool regressed = false;
 
 public:
-	SDL_Window* window;
+	SDL_Window* window = nullptr;
 
 	application();
 
+	explicit application(const vkx::ApplicationSettings& settings);
+
 	~application();
 
 	void run();
 
+	// True when the last run was slower than the baseline by more than the threshold.
+	[[nodiscard]] bool hasRegressed() const noexcept;
+
 	void poll();
+
+	// Advances the simulation by one fixed tick and publishes its snapshot.
+	void tick();
+
+	// Returns false when the frame was dropped because the swapchain had to be recreated.
+	bool render(std::uint32_t currentFrame);
+
+private:
+	// Runs on the simulation thread, ticking at the fixed rate until stopped.
+	void simulate();
+
+	void stopSimulation();
+
+	void publishInput();
+
+	void updateHighlight(const vkx::InputState& state);
+
+	// The loaded chunk at the chunk coordinate, nullptr while it is outside the window or still being built.
+	[[nodiscard]] const vkx::VoxelChunk2D* readyChunk(const glm::ivec2& chunk) const;
+
+	void recreateSwapchain();
+
+	void replay();
+
+	void collectStatistics(std::uint32_t frameCount, std::chrono::steady_clock::time_point frameStart);
+
+	void reportStatistics();
+
+	void handleEvent(const SDL_Event& event);
+
+	void keyPressed(const SDL_KeyboardEvent& key);
+
+	void keyReleased(const SDL_KeyboardEvent& key);
+
+	void mouseMoved(const SDL_MouseMotionEvent& motion);
+
+	void mouseButton(const SDL_MouseButtonEvent& button);
 };
 }
@@ -0,0 +1,80 @@
+#pragma once
+
+namespace vkx {
+enum class AssetType : std::uint32_t {
+	Shader,
+	// RGBA8 pixels of every layer one after another, mipmaps are generated on upload.
+	Texture
+};
+
+struct AssetView {
+	vkx::AssetType type = vkx::AssetType::Shader;
+	const std::uint8_t* data = nullptr;
+	std::size_t size = 0;
+	std::uint32_t width = 0;
+	std::uint32_t height = 0;
+	std::uint32_t layers = 0;
+};
+
+// Packs are stored in host byte order: a "VKXP" magic, version and entry count, a fixed size
+// index of named entries, then every entry's data aligned to ASSET_ALIGNMENT bytes.
+static constexpr std::size_t ASSET_NAME_SIZE = 64;
+
+static constexpr std::size_t ASSET_ALIGNMENT = 16;
+
+// Read only view of a pack mapped into memory, entries point straight into the mapping.
+class AssetPack {
+private:
+	struct Entry {
+		std::array<char, vkx::ASSET_NAME_SIZE> name;
+		vkx::AssetType type;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t layers;
+		std::uint64_t offset;
+		std::uint64_t size;
+	};
+
+	const std::uint8_t* mapping = nullptr;
+	std::size_t mappingSize = 0;
+	std::unordered_map<std::string, vkx::AssetView> assets{};
+
+public:
+	AssetPack() = default;
+
+	// Leaves the pack closed when the file does not exist, throws when it is not a valid pack.
+	explicit AssetPack(const std::string& file);
+
+	[[nodiscard]] bool isOpen() const noexcept;
+
+	[[nodiscard]] const vkx::AssetView* find(const std::string& name) const;
+
+	void destroy();
+
+	friend class AssetPackWriter;
+};
+
+class AssetPackWriter {
+private:
+	struct PendingAsset {
+		std::string name;
+		vkx::AssetType type;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t layers;
+		std::vector<std::uint8_t> data;
+	};
+
+	std::vector<PendingAsset> pending{};
+
+public:
+	AssetPackWriter() = default;
+
+	void addShader(const std::string& name, const std::string& file);
+
+	// Decodes every file into one layer, all files must share the same dimensions.
+	void addTexture(const std::string& name, const std::vector<std::string>& files);
+
+	void write(const std::string& file) const;
+};
+} // namespace vkx
@@ -0,0 +1,107 @@
+#pragma once
+
+namespace vkx {
+static constexpr std::size_t MAX_COMPONENTS = 64;
+
+// Bit i is set for the component with id i.
+using ComponentMask = std::uint64_t;
+
+struct ComponentInfo {
+	std::size_t size = 0;
+	std::size_t alignment = 0;
+};
+
+// Ids are handed out in the order component types are first used, throws past MAX_COMPONENTS.
+[[nodiscard]] std::uint32_t registerComponent(std::size_t size, std::size_t alignment);
+
+[[nodiscard]] const vkx::ComponentInfo& componentInfo(std::uint32_t id);
+
+template <class T>
+std::uint32_t componentId() {
+	static_assert(std::is_trivially_copyable_v<T>, "Components are moved between archetypes as bytes.");
+	static_assert(alignof(T) <= alignof(std::max_align_t), "Chunk storage is only aligned to std::max_align_t.");
+
+	static const auto id = registerComponent(sizeof(T), alignof(T));
+	return id;
+}
+
+template <class... Ts>
+vkx::ComponentMask componentMask() {
+	return (vkx::ComponentMask{0} | ... | (vkx::ComponentMask{1} << componentId<Ts>()));
+}
+
+struct Entity {
+	std::uint32_t index = 0;
+	// Bumped when the index is reused, so handles to destroyed entities stay invalid.
+	std::uint32_t generation = 0;
+
+	bool operator==(const Entity& other) const noexcept {
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!=(const Entity& other) const noexcept {
+		return !(*this == other);
+	}
+};
+
+// Every entity with exactly the same set of components. They are stored in fixed size chunks holding one array per
+// component, so iterating a component touches consecutive memory and nothing else.
+class Archetype {
+public:
+	static constexpr std::size_t CHUNK_BYTES = 16 * 1024;
+
+private:
+	struct Chunk {
+		std::unique_ptr<std::max_align_t[]> memory{};
+		std::vector<vkx::Entity> entities{};
+	};
+
+	vkx::ComponentMask mask = 0;
+	std::vector<std::uint32_t> components{};
+	// Start of each component's array within a chunk, by component id.
+	std::array<std::size_t, vkx::MAX_COMPONENTS> offsets{};
+	// Copied from the component table, which is shared between threads and locked.
+	std::array<std::size_t, vkx::MAX_COMPONENTS> sizes{};
+	std::size_t chunkBytes = 0;
+	std::size_t capacity = 0;
+	std::vector<Chunk> chunks{};
+	std::size_t count = 0;
+
+public:
+	explicit Archetype(vkx::ComponentMask mask);
+
+	[[nodiscard]] vkx::ComponentMask getMask() const noexcept;
+
+	[[nodiscard]] const std::vector<std::uint32_t>& getComponents() const noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	[[nodiscard]] std::size_t componentSize(std::uint32_t id) const noexcept;
+
+	// Entities each chunk holds when full.
+	[[nodiscard]] std::size_t getCapacity() const noexcept;
+
+	// Chunks in use, all of them full except the last.
+	[[nodiscard]] std::size_t chunkCount() const noexcept;
+
+	[[nodiscard]] std::size_t chunkSize(std::size_t chunk) const noexcept;
+
+	[[nodiscard]] const vkx::Entity* entities(std::size_t chunk) const noexcept;
+
+	[[nodiscard]] std::byte* column(std::size_t chunk, std::uint32_t component) const noexcept;
+
+	template <class T>
+	[[nodiscard]] T* column(std::size_t chunk) const noexcept {
+		return reinterpret_cast<T*>(column(chunk, componentId<T>()));
+	}
+
+	// Address of a component of the entity in the given row, counted across all chunks.
+	[[nodiscard]] std::byte* component(std::size_t row, std::uint32_t id) const noexcept;
+
+	// Appends a row for the entity with its components left uninitialized, returns the row.
+	std::size_t push(const vkx::Entity& entity);
+
+	// Fills the hole with the last row, returns the entity that moved into it or nothing if the last row was removed.
+	std::optional<vkx::Entity> swapRemove(std::size_t row);
+};
+} // namespace vkx
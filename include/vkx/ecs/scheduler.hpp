@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vkx/ecs/world.hpp>
+
+namespace vkx {
+// Runs systems over a world in the order they were added, except that systems which do not conflict run side by
+// side. Two systems conflict when one writes a component the other reads or writes, the later one then waits for
+// the earlier one. Systems sharing a stage must not make structural changes or use the pool themselves, a system
+// alone in its stage may do both.
+class SystemScheduler {
+private:
+	struct System {
+		// Also the profiling zone name, so it must outlive the profiler.
+		const char* name = nullptr;
+		vkx::ComponentMask reads = 0;
+		vkx::ComponentMask writes = 0;
+		std::function<void(vkx::World&)> run{};
+	};
+
+	std::vector<System> systems{};
+	// Indices of systems run together, stages run one after another.
+	std::vector<std::vector<std::size_t>> stages{};
+
+public:
+	SystemScheduler() = default;
+
+	// Masks come from componentMask, e.g. componentMask<Position, Velocity>().
+	void add(const char* name, vkx::ComponentMask reads, vkx::ComponentMask writes, std::function<void(vkx::World&)> system);
+
+	void run(vkx::World& world, vkx::ThreadPool& pool);
+
+	[[nodiscard]] const std::vector<std::vector<std::size_t>>& getStages() const noexcept;
+
+private:
+	[[nodiscard]] static bool conflicts(const System& first, const System& second) noexcept;
+};
+} // namespace vkx
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vkx/ecs/archetype.hpp>
+#include <vkx/thread_pool.hpp>
+
+namespace vkx {
+// Entities and their components, grouped by archetype. Adding or removing a component moves an entity to another
+// archetype, so queries only visit archetypes that have every component asked for and then run over plain arrays.
+// Structural changes (create, destroy, add, remove) must not overlap with anything else touching the world, reading
+// and writing components of different types from several threads is fine.
+class World {
+private:
+	struct Record {
+		std::uint32_t archetype = 0;
+		std::size_t row = 0;
+		std::uint32_t generation = 0;
+		bool alive = false;
+	};
+
+	std::vector<std::unique_ptr<vkx::Archetype>> archetypes{};
+	std::unordered_map<vkx::ComponentMask, std::uint32_t> archetypeIndices{};
+	std::vector<Record> records{};
+	std::vector<std::uint32_t> freeIndices{};
+	std::size_t aliveCount = 0;
+
+public:
+	World();
+
+	template <class... Ts>
+	vkx::Entity create(const Ts&... components) {
+		const auto entity = allocate(componentMask<Ts...>());
+		(std::memcpy(component(entity, componentId<Ts>()), &components, sizeof(Ts)), ...);
+		return entity;
+	}
+
+	void destroy(const vkx::Entity& entity);
+
+	[[nodiscard]] bool isAlive(const vkx::Entity& entity) const noexcept;
+
+	// Entities alive.
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	// Adds the component, or overwrites it when the entity already has one.
+	template <class T>
+	void add(const vkx::Entity& entity, const T& value) {
+		const auto id = componentId<T>();
+		move(entity, maskOf(entity) | (vkx::ComponentMask{1} << id));
+		std::memcpy(component(entity, id), &value, sizeof(T));
+	}
+
+	template <class T>
+	void remove(const vkx::Entity& entity) {
+		move(entity, maskOf(entity) & ~(vkx::ComponentMask{1} << componentId<T>()));
+	}
+
+	template <class T>
+	[[nodiscard]] bool has(const vkx::Entity& entity) const {
+		return (maskOf(entity) & (vkx::ComponentMask{1} << componentId<T>())) != 0;
+	}
+
+	// Throws when the entity does not have the component. The reference is invalidated by structural changes.
+	template <class T>
+	[[nodiscard]] T& get(const vkx::Entity& entity) {
+		if (!has<T>(entity)) {
+			throw std::runtime_error("Entity does not have the component.");
+		}
+
+		return *reinterpret_cast<T*>(component(entity, componentId<T>()));
+	}
+
+	// Calls f(count, entities, arrays...) once per chunk of every archetype with all of Ts, with one array per component.
+	template <class... Ts, class F>
+	void eachChunk(F f) {
+		const auto mask = componentMask<Ts...>();
+		for (const auto& archetype : archetypes) {
+			if ((archetype->getMask() & mask) != mask) {
+				continue;
+			}
+
+			for (std::size_t chunk = 0; chunk < archetype->chunkCount(); chunk++) {
+				f(archetype->chunkSize(chunk), archetype->entities(chunk), archetype->template column<Ts>(chunk)...);
+			}
+		}
+	}
+
+	// Calls f(components...) for every entity with all of Ts.
+	template <class... Ts, class F>
+	void each(F f) {
+		eachChunk<Ts...>([&f](std::size_t count, const vkx::Entity*, Ts*... columns) {
+			for (std::size_t i = 0; i < count; i++) {
+				f(columns[i]...);
+			}
+		});
+	}
+
+	// Like each, with chunks spread over the pool's threads. f is called concurrently and must only touch its own entity.
+	template <class... Ts, class F>
+	void parallelEach(vkx::ThreadPool& pool, F f) {
+		const auto mask = componentMask<Ts...>();
+
+		std::vector<std::pair<const vkx::Archetype*, std::size_t>> chunks{};
+		for (const auto& archetype : archetypes) {
+			if ((archetype->getMask() & mask) != mask) {
+				continue;
+			}
+
+			for (std::size_t chunk = 0; chunk < archetype->chunkCount(); chunk++) {
+				chunks.emplace_back(archetype.get(), chunk);
+			}
+		}
+
+		pool.run(chunks.size(), [&chunks, &f](std::size_t task) {
+			const auto [archetype, chunk] = chunks[task];
+			const auto count = archetype->chunkSize(chunk);
+			const auto columns = std::make_tuple(archetype->template column<Ts>(chunk)...);
+			for (std::size_t i = 0; i < count; i++) {
+				f(std::get<Ts*>(columns)[i]...);
+			}
+		});
+	}
+
+	[[nodiscard]] std::size_t archetypeCount() const noexcept;
+
+private:
+	[[nodiscard]] vkx::Entity allocate(vkx::ComponentMask mask);
+
+	// Throws when the entity was destroyed.
+	[[nodiscard]] const Record& recordOf(const vkx::Entity& entity) const;
+
+	[[nodiscard]] Record& recordOf(const vkx::Entity& entity);
+
+	[[nodiscard]] vkx::ComponentMask maskOf(const vkx::Entity& entity) const;
+
+	[[nodiscard]] std::byte* component(const vkx::Entity& entity, std::uint32_t id) const;
+
+	std::uint32_t archetypeFor(vkx::ComponentMask mask);
+
+	// Moves the entity to the archetype of mask, keeping the components both archetypes share.
+	void move(const vkx::Entity& entity, vkx::ComponentMask mask);
+
+	// Takes the entity's row out of its archetype and points the entity that filled the hole at it.
+	void removeRow(const Record& record);
+};
+} // namespace vkx
@@ -6,7 +6,9 @@
 #include <SDL2/SDL_vulkan.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <functional>
 #include <shaderc/shaderc.hpp>
@@ -16,19 +18,31 @@
 #define GLM_FORCE_LEFT_HANDED
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <cmath>
 #include <cstring>
 #include <glm/glm.hpp>
 #include <glm/gtc/noise.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/matrix_transform_2d.hpp>
+#include <iomanip>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 #ifdef NDEBUG
 #define RELEASE
 #else
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vkx/physics/spatial_hash.hpp>
+#include <vkx/physics/voxel_collision.hpp>
+#include <vkx/thread_pool.hpp>
+
+namespace vkx {
+// Axis aligned box moving through the voxel grid, in voxels and voxels per tick.
+struct Body {
+	// Minimum corner.
+	glm::vec2 position{0};
+	glm::vec2 size{1};
+	glm::vec2 velocity{0};
+	// Axes the last step's move was cut short on by voxels.
+	bool blockedX = false;
+	bool blockedY = false;
+};
+
+// Two overlapping bodies, a is always the lower index and normal points from a to b.
+struct Contact {
+	std::uint32_t a = 0;
+	std::uint32_t b = 0;
+	glm::vec2 normal{0};
+	float depth = 0.0f;
+};
+
+// Bodies pushing each other apart and sliding along voxels. Every step finds overlapping pairs through a spatial hash,
+// splits their overlap between them and sweeps each body through the voxels by its velocity plus that push. Pair
+// tests and sweeps are spread over a thread pool, results do not depend on how many threads it has.
+class PhysicsWorld {
+public:
+	// Work handed to a thread at a time, small enough to balance and large enough to amortize taking it.
+	static constexpr std::size_t CELLS_PER_TASK = 64;
+	static constexpr std::size_t BODIES_PER_TASK = 256;
+
+private:
+	std::vector<vkx::Body> bodies{};
+	vkx::SpatialHash hash{};
+	std::vector<std::vector<vkx::Contact>> taskContacts{};
+	std::vector<vkx::Contact> contacts{};
+	std::vector<glm::vec2> pushes{};
+
+public:
+	PhysicsWorld() = default;
+
+	explicit PhysicsWorld(float cellSize);
+
+	std::uint32_t add(const vkx::Body& body);
+
+	// Bodies may be moved or resized freely between steps.
+	[[nodiscard]] vkx::Body& get(std::uint32_t body);
+
+	[[nodiscard]] const vkx::Body& get(std::uint32_t body) const;
+
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	// Overlaps found by the last step, ordered by body.
+	[[nodiscard]] const std::vector<vkx::Contact>& getContacts() const noexcept;
+
+	// Advances every body by one tick, lookup(chunkCoordinate) must be safe to call from the pool's threads.
+	template <class Lookup>
+	void step(Lookup lookup, vkx::ThreadPool& pool) {
+		updateHash();
+		findContacts(pool);
+
+		pool.run((bodies.size() + BODIES_PER_TASK - 1) / BODIES_PER_TASK, [this, &lookup](std::size_t task) {
+			const auto end = std::min(bodies.size(), (task + 1) * BODIES_PER_TASK);
+			for (auto i = task * BODIES_PER_TASK; i < end; i++) {
+				auto& body = bodies[i];
+				const auto result = vkx::sweepBox(body.position, body.size, body.velocity + pushes[i], lookup);
+				body.position = result.position;
+				body.blockedX = result.blockedX;
+				body.blockedY = result.blockedY;
+			}
+		});
+	}
+
+private:
+	void updateHash();
+
+	// Fills contacts and the push each body gets from them.
+	void findContacts(vkx::ThreadPool& pool);
+};
+} // namespace vkx
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace vkx {
+// Uniform grid of square cells over the plane, only cells holding bodies are stored. Bodies are kept in every cell
+// their box overlaps and are only moved between cells when the range of cells they overlap changes.
+class SpatialHash {
+public:
+	struct Cell {
+		glm::ivec2 coordinate{0};
+		std::vector<std::uint32_t> bodies{};
+	};
+
+private:
+	// Cells overlapped by a body, max inclusive. Empty when min is greater than max.
+	struct CellRange {
+		glm::ivec2 min{0};
+		glm::ivec2 max{-1};
+	};
+
+	float cellSize = 1.0f;
+	std::vector<Cell> cells{};
+	std::unordered_map<std::uint64_t, std::size_t> cellIndices{};
+	std::vector<CellRange> ranges{};
+
+public:
+	SpatialHash() = default;
+
+	// Cells should be about as large as the larger bodies, so most bodies overlap one to four cells.
+	explicit SpatialHash(float cellSize);
+
+	[[nodiscard]] float getCellSize() const noexcept;
+
+	[[nodiscard]] glm::ivec2 cellCoordinate(const glm::vec2& position) const noexcept;
+
+	// Inserts the body or moves it to the cells its box now overlaps.
+	void update(std::uint32_t body, const glm::vec2& min, const glm::vec2& max);
+
+	void remove(std::uint32_t body);
+
+	// Cells holding at least one body, in no particular order.
+	[[nodiscard]] const std::vector<Cell>& occupiedCells() const noexcept;
+
+private:
+	[[nodiscard]] static std::uint64_t key(const glm::ivec2& coordinate) noexcept;
+
+	void insert(std::uint32_t body, const CellRange& range);
+
+	void erase(std::uint32_t body, const CellRange& range);
+};
+} // namespace vkx
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+// Gap kept between a box and the voxels it rests against, so touching is not mistaken for overlapping.
+static constexpr float COLLISION_EPSILON = 1.0f / 1024.0f;
+
+struct SweepResult {
+	// Minimum corner of the box after the move.
+	glm::vec2 position{0};
+	// Axes the move was cut short on.
+	bool blockedX = false;
+	bool blockedY = false;
+};
+
+// Moves an axis aligned box, given by its minimum corner and size in voxels, by motion through the voxel grid.
+// The box moves along x and then y, and each axis stops at the first solid voxel its leading edge would enter, so only
+// the voxels the box sweeps over are looked at. lookup(chunkCoordinate) returns the chunk or nullptr when it is not
+// loaded, unloaded chunks and air never block. Boxes already overlapping solid voxels can always move out of them.
+template <class Lookup>
+SweepResult sweepBox(const glm::vec2& position, const glm::vec2& size, const glm::vec2& motion, Lookup lookup) {
+	constexpr auto chunkSize = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+	// The last chunk looked up, the cells of one sweep almost always share it.
+	glm::ivec2 cachedChunk{std::numeric_limits<std::int32_t>::max()};
+	const vkx::VoxelChunk2D* cached = nullptr;
+
+	const auto isSolid = [&](const glm::ivec2& cell) {
+		const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+		if (chunkPosition != cachedChunk) {
+			cachedChunk = chunkPosition;
+			cached = lookup(chunkPosition);
+		}
+
+		if (!cached) {
+			return false;
+		}
+
+		const auto local = cell - chunkPosition * chunkSize;
+		return ((cached->rowOccupancy[static_cast<std::size_t>(local.y)] >> local.x) & 1) != 0;
+	};
+
+	SweepResult result{position};
+	for (glm::length_t axis = 0; axis < 2; axis++) {
+		const auto distance = motion[axis];
+		if (distance == 0.0f) {
+			continue;
+		}
+
+		const glm::length_t across = 1 - axis;
+		const auto firstAcross = static_cast<std::int32_t>(std::floor(result.position[across] + COLLISION_EPSILON));
+		const auto lastAcross = static_cast<std::int32_t>(std::ceil(result.position[across] + size[across] - COLLISION_EPSILON)) - 1;
+
+		const auto blockedBy = [&](std::int32_t line) {
+			for (auto i = firstAcross; i <= lastAcross; i++) {
+				glm::ivec2 cell{0};
+				cell[axis] = line;
+				cell[across] = i;
+				if (isSolid(cell)) {
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		auto blocked = false;
+		if (distance > 0.0f) {
+			// Lines of voxels the leading edge enters, the line it already overlaps is skipped.
+			const auto edge = result.position[axis] + size[axis];
+			const auto first = static_cast<std::int32_t>(std::ceil(edge - COLLISION_EPSILON));
+			const auto last = static_cast<std::int32_t>(std::ceil(edge + distance)) - 1;
+			for (auto line = first; line <= last && !blocked; line++) {
+				if (blockedBy(line)) {
+					// Never backwards, a box within the gap of the wall stays where it is.
+					result.position[axis] = std::max(result.position[axis], static_cast<float>(line) - size[axis] - COLLISION_EPSILON);
+					blocked = true;
+				}
+			}
+		} else {
+			const auto edge = result.position[axis];
+			const auto first = static_cast<std::int32_t>(std::floor(edge + COLLISION_EPSILON)) - 1;
+			const auto last = static_cast<std::int32_t>(std::floor(edge + distance));
+			for (auto line = first; line >= last && !blocked; line--) {
+				if (blockedBy(line)) {
+					result.position[axis] = std::min(result.position[axis], static_cast<float>(line + 1) + COLLISION_EPSILON);
+					blocked = true;
+				}
+			}
+		}
+
+		if (!blocked) {
+			result.position[axis] += distance;
+		}
+
+		(axis == 0 ? result.blockedX : result.blockedY) = blocked;
+	}
+
+	return result;
+}
+} // namespace vkx
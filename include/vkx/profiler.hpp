@@ -0,0 +1,57 @@
+#pragma once
+
+namespace vkx {
+namespace profiler {
+// Zones recorded per thread before the oldest ones are overwritten.
+static constexpr std::size_t RING_CAPACITY = std::size_t{1} << 16;
+
+struct Zone {
+	const char* name = nullptr;
+	std::uint64_t begin = 0;
+	std::uint64_t end = 0;
+};
+
+// The invariant TSC is monotonic and several times cheaper to read than steady_clock,
+// ticks are converted to nanoseconds against steady_clock when a trace is written.
+inline std::uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+	return __rdtsc();
+#else
+	const auto time = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+#endif
+}
+
+// Names must outlive the profiler, string literals are expected.
+void record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+// Writes every zone currently held by the thread ring buffers in the Chrome trace event format.
+bool writeChromeTrace(const std::string& file);
+
+class ScopedZone {
+private:
+	const char* name;
+	std::uint64_t begin;
+
+public:
+	explicit ScopedZone(const char* name) noexcept
+	    : name(name), begin(ticks()) {}
+
+	ScopedZone(const ScopedZone& other) = delete;
+
+	~ScopedZone() {
+		record(name, begin, ticks());
+	}
+
+	ScopedZone& operator=(const ScopedZone& other) = delete;
+};
+} // namespace profiler
+} // namespace vkx
+
+#ifdef VKX_PROFILING
+#define VKX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VKX_PROFILE_CONCAT(a, b) VKX_PROFILE_CONCAT_IMPL(a, b)
+#define VKX_PROFILE_ZONE(name) const vkx::profiler::ScopedZone VKX_PROFILE_CONCAT(profileZone, __LINE__) { name }
+#else
+#define VKX_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
@@ -1,8 +1,6 @@
 #pragma once
 
 namespace vkx {
-using RaycastPredicate = std::function<bool(const glm::ivec3&)>;
-
 struct RaycastResult {
 	bool success = false;
 	glm::ivec3 hitPos = glm::ivec3{0};
@@ -10,8 +8,6 @@ struct RaycastResult {
 	float length = 0.0f;
 };
 
-RaycastResult raycast(const glm::vec3& origin, const glm::vec3& direction, float maxLength, RaycastPredicate predicate);
-
 struct Raycast2DResult {
 	bool success = false;
 	float length = 0.0f;
@@ -36,6 +32,13 @@ static constexpr glm::ivec2 derriveStep(const glm::vec2& direction) noexcept {
 		derriveStep(direction.y)};
 }
 
+// Z steps against its direction.
+static constexpr glm::ivec3 derriveStep(const glm::vec3& direction) noexcept {
+	return {derriveStep(direction.x),
+		derriveStep(direction.y),
+		-derriveStep(direction.z)};
+}
+
 static constexpr auto derriveDelta(int step, float direction) noexcept {
 	if (step != 0) {
 		return 1.0f / glm::abs(direction);
@@ -51,6 +54,12 @@ static constexpr glm::vec2 derriveDelta(const glm::ivec2& step, const glm::vec2&
 		derriveDelta(step.y, direction.y)};
 }
 
+static constexpr glm::vec3 derriveDelta(const glm::ivec3& step, const glm::vec3& direction) noexcept {
+	return {derriveDelta(step.x, direction.x),
+		derriveDelta(step.y, direction.y),
+		derriveDelta(step.z, direction.z)};
+}
+
 static constexpr auto derriveCross(int step, float origin, float delta) noexcept {
 	if (step != 0) {
 		if (step == 1) {
@@ -68,6 +77,63 @@ static constexpr glm::vec2 derriveCross(const glm::ivec2& step, const glm::vec2&
 		derriveCross(step.y, origin.y, delta.y)};
 }
 
+static constexpr glm::vec3 derriveCross(const glm::ivec3& step, const glm::vec3& origin, const glm::vec3& delta) noexcept {
+	return {derriveCross(step.x, origin.x, delta.x),
+		derriveCross(step.y, origin.y, delta.y),
+		derriveCross(step.z, origin.z, delta.z)};
+}
+
+// The predicate is a template parameter so every step calls it directly instead of through a std::function.
+template <class T>
+RaycastResult raycast(const glm::vec3& origin, const glm::vec3& direction, float maxLength, T predicate) {
+	const auto step = derriveStep(direction);
+	const auto delta = derriveDelta(step, direction);
+	auto cross = derriveCross(step, origin, delta);
+	glm::ivec3 hitPos = glm::floor(origin);
+	glm::ivec3 previousHitPos = hitPos;
+	float length = 0.0f;
+
+	do {
+		previousHitPos = hitPos;
+
+		if (cross.x < cross.y) {
+			if (cross.x < cross.z) {
+				hitPos.x += step.x;
+
+				length = cross.x;
+
+				cross.x += delta.x;
+			} else {
+				hitPos.z += step.z;
+
+				length = cross.z;
+
+				cross.z += delta.z;
+			}
+		} else {
+			if (cross.y < cross.z) {
+				hitPos.y += step.y;
+
+				length = cross.y;
+
+				cross.y += delta.y;
+			} else {
+				hitPos.z += step.z;
+
+				length = cross.z;
+
+				cross.z += delta.z;
+			}
+		}
+
+		if (length > maxLength) {
+			return RaycastResult{false, glm::ivec3{0}, glm::ivec3{0}, length};
+		}
+	} while (!predicate(hitPos));
+
+	return RaycastResult{true, hitPos, previousHitPos, length};
+}
+
 template <class T>
 Raycast2DResult raycast2D(const glm::vec2& origin, const glm::vec2& direction, float maxLength, T predicate) {
 	const auto step = derriveStep(direction);
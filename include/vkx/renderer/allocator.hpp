@@ -5,13 +5,24 @@ class Image;
 class CommandSubmitter;
 struct UniformBuffer;
 
+struct MemoryHeapBudget {
+	// Bytes of the heap in use by the process, or by vkx's own memory blocks without VK_EXT_memory_budget.
+	std::uint64_t usage = 0;
+	// Bytes the process can use before the driver starts to page or fail allocations.
+	std::uint64_t budget = 0;
+	// Bytes of vkx's live allocations, which drops as soon as a buffer is freed.
+	std::uint64_t allocationBytes = 0;
+	std::uint64_t size = 0;
+	bool deviceLocal = false;
+};
+
 class Buffer {
 private:
-	VmaAllocator allocator;
-	VkBuffer buffer;
-	VmaAllocation allocation;
-	std::size_t allocationSize;
-	void* mappedData;
+	VmaAllocator allocator = nullptr;
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VmaAllocation allocation = nullptr;
+	std::size_t allocationSize = 0;
+	void* mappedData = nullptr;
 
 public:
 	Buffer() = default;
@@ -24,6 +35,11 @@ public:
 
 	void mapMemory(const void* data) const;
 
+	void mapMemory(const void* data, std::size_t size) const;
+
+	// Copies into the buffer starting at offset bytes, clamped to the end of the buffer.
+	void mapMemory(const void* data, std::size_t size, std::size_t offset) const;
+
 	std::size_t size() const;
 };
 } // namespace vkx
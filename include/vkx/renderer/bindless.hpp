@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vkx/renderer/allocator.hpp>
+
+namespace vkx {
+// Pushed per draw, selects an element of a storage buffer in the table.
+struct BindlessDrawIndices {
+	std::uint32_t objectBuffer = 0;
+	std::uint32_t object = 0;
+};
+
+// One descriptor set of runtime sized texture and storage buffer arrays, bound once and indexed from shaders.
+// Entries are only ever appended, so the set stays valid while earlier frames still use it.
+class BindlessTable {
+public:
+	static constexpr std::uint32_t SET = 1;
+	static constexpr std::uint32_t TEXTURE_BINDING = 0;
+	static constexpr std::uint32_t BUFFER_BINDING = 1;
+	static constexpr std::uint32_t MAX_TEXTURES = 1024;
+	static constexpr std::uint32_t MAX_BUFFERS = 1024;
+
+private:
+	vk::Device logicalDevice{};
+	vk::DescriptorSetLayout descriptorLayout{};
+	vk::DescriptorPool descriptorPool{};
+	vk::DescriptorSet descriptorSet{};
+	std::uint32_t textureCount = 0;
+	std::uint32_t bufferCount = 0;
+
+public:
+	BindlessTable() = default;
+
+	explicit BindlessTable(vk::Device logicalDevice);
+
+	// Returns the index shaders use to sample the texture.
+	std::uint32_t addTexture(const vkx::Texture& texture);
+
+	// Returns the index shaders use to read the buffer.
+	std::uint32_t addBuffer(const vkx::Buffer& buffer);
+
+	[[nodiscard]] vk::DescriptorSetLayout getLayout() const noexcept;
+
+	[[nodiscard]] vk::DescriptorSet getSet() const noexcept;
+
+	void destroy();
+};
+} // namespace vkx
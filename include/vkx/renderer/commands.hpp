@@ -1,9 +1,12 @@
 #pragma once
 
+#include <vkx/renderer/bindless.hpp>
+#include <vkx/renderer/gpu_profiler.hpp>
 #include <vkx/renderer/model.hpp>
 #include <vkx/renderer/pipeline.hpp>
 #include <vkx/renderer/renderer.hpp>
 #include <vkx/renderer/sync_objects.hpp>
+#include <vkx/renderer/upload_batch.hpp>
 
 namespace vkx {
 struct DrawInfo {
@@ -11,7 +14,10 @@ struct DrawInfo {
 	const std::uint32_t currentFrame = 0;
 	const vkx::VulkanInstance::Swapchain* swapchain{};
 	const vkx::pipeline::GraphicsPipeline* graphicsPipeline{};
-	const std::vector<vkx::Mesh>& meshes;
+	const std::vector<vkx::MeshHandle>& meshes;
+	vkx::GPUProfiler* const profiler = nullptr;
+	// Table index of the storage buffer holding one element per mesh, only used by bindless pipelines.
+	const std::uint32_t objectBuffer = 0;
 };
 
 class CommandSubmitter {
@@ -20,6 +26,7 @@ private:
 	vk::CommandPool commandPool{};
 	vk::Queue graphicsQueue{};
 	vk::Queue presentQueue{};
+	vkx::GPUProfiler* profiler = nullptr;
 
 public:
 	CommandSubmitter() = default;
@@ -30,33 +37,20 @@ public:
 
 	void destroy();
 
-	template <class T>
-	void submitImmediately(T command) const {
-		const vk::CommandBufferAllocateInfo commandBufferAllocateInfo{
-		    commandPool,
-		    vk::CommandBufferLevel::ePrimary,
-		    1};
-
-		const vk::UniqueCommandBuffer commandBuffer = std::move(logicalDevice.allocateCommandBuffersUnique(commandBufferAllocateInfo)[0]);
-
-		const vk::CommandBufferBeginInfo commandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit};
-
-		commandBuffer->begin(commandBufferBeginInfo);
+	void setProfiler(vkx::GPUProfiler* gpuProfiler) noexcept;
 
-		command(*commandBuffer);
+	// Batches begin recording right away and must be destroyed by the caller once they are no longer needed.
+	[[nodiscard]] vkx::UploadBatch createUploadBatch() const;
 
-		commandBuffer->end();
-
-		const vk::SubmitInfo submitInfo{{}, {}, *commandBuffer};
-
-		graphicsQueue.submit(submitInfo);
-		graphicsQueue.waitIdle();
+	// Submits a single command and waits for it, prefer an upload batch when there is more than one.
+	template <class T>
+	void submitImmediately(T command) const {
+		auto batch = createUploadBatch();
+		batch.record(command);
+		batch.wait();
+		batch.destroy();
 	}
 
-	void transitionImageLayout(vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout) const;
-
-	void copyBufferToImage(vk::Buffer buffer, vk::Image image, std::uint32_t width, std::uint32_t height) const;
-
 	std::vector<vk::CommandBuffer> allocateDrawCommands(std::uint32_t amount, vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary) const;
 
 	template <class T>
@@ -105,13 +99,20 @@ public:
 
 			commandBuffer.setScissor(0, renderArea);
 
-			commandBuffer.bindVertexBuffers(0, static_cast<vk::Buffer>(mesh.vertexBuffer), {0});
+			commandBuffer.bindVertexBuffers(0, mesh.vertexBuffer, {0});
 
-			commandBuffer.bindIndexBuffer(static_cast<vk::Buffer>(mesh.indexBuffer), 0, vk::IndexType::eUint32);
+			commandBuffer.bindIndexBuffer(mesh.indexBuffer, 0, vk::IndexType::eUint32);
 
 			commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, drawInfo.graphicsPipeline->pipelineLayout, 0, drawInfo.graphicsPipeline->descriptorSets[drawInfo.currentFrame], {});
 
-			commandBuffer.drawIndexed(static_cast<std::uint32_t>(mesh.activeIndexCount), 1, 0, 0, 0);
+			if (drawInfo.graphicsPipeline->bindlessSet) {
+				commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, drawInfo.graphicsPipeline->pipelineLayout, vkx::BindlessTable::SET, drawInfo.graphicsPipeline->bindlessSet, {});
+
+				const vkx::BindlessDrawIndices indices{drawInfo.objectBuffer, mesh.object};
+				commandBuffer.pushConstants(drawInfo.graphicsPipeline->pipelineLayout, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(indices), &indices);
+			}
+
+			commandBuffer.drawIndexed(mesh.indexCount, 1, 0, 0, 0);
 
 			commandBuffer.endRenderPass();
 
@@ -165,6 +166,12 @@ public:
 
 			commandBuffer.begin(commandBufferBeginInfo);
 
+			auto renderPassScope = vkx::GPUProfiler::NO_SCOPE;
+			if (drawInfo.profiler && i == 0) {
+				drawInfo.profiler->beginFrame(commandBuffer, drawInfo.currentFrame);
+				renderPassScope = drawInfo.profiler->beginScope(commandBuffer, drawInfo.currentFrame, "render pass");
+			}
+
 			commandBuffer.beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eSecondaryCommandBuffers);
 
 			for (std::uint32_t j = 0; j < secondarySize; j++) {
@@ -179,21 +186,44 @@ public:
 
 				secondaryCommandBuffer.setScissor(0, renderArea);
 
-				secondaryCommandBuffer.bindVertexBuffers(0, static_cast<vk::Buffer>(mesh.vertexBuffer), {0});
+				secondaryCommandBuffer.bindVertexBuffers(0, mesh.vertexBuffer, {0});
 
-				secondaryCommandBuffer.bindIndexBuffer(static_cast<vk::Buffer>(mesh.indexBuffer), 0, vk::IndexType::eUint32);
+				secondaryCommandBuffer.bindIndexBuffer(mesh.indexBuffer, 0, vk::IndexType::eUint32);
 
 				secondaryCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, drawInfo.graphicsPipeline->pipelineLayout, 0, drawInfo.graphicsPipeline->descriptorSets[drawInfo.currentFrame], {});
 
-				secondaryCommandBuffer.drawIndexed(static_cast<std::uint32_t>(mesh.activeIndexCount), 1, 0, 0, 0);
+				if (drawInfo.graphicsPipeline->bindlessSet) {
+					secondaryCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, drawInfo.graphicsPipeline->pipelineLayout, vkx::BindlessTable::SET, drawInfo.graphicsPipeline->bindlessSet, {});
+
+					const vkx::BindlessDrawIndices indices{drawInfo.objectBuffer, mesh.object};
+					secondaryCommandBuffer.pushConstants(drawInfo.graphicsPipeline->pipelineLayout, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(indices), &indices);
+				}
+
+				secondaryCommandBuffer.drawIndexed(mesh.indexCount, 1, 0, 0, 0);
 
 				secondaryCommandBuffer.end();
 			}
 
-			commandBuffer.executeCommands(secondarySize, secondaryBegin);
+			auto executeScope = vkx::GPUProfiler::NO_SCOPE;
+			if (drawInfo.profiler && i == 0) {
+				executeScope = drawInfo.profiler->beginScope(commandBuffer, drawInfo.currentFrame, "chunk draws");
+			}
+
+			// Nothing may be visible, executing zero command buffers is invalid.
+			if (secondarySize > 0) {
+				commandBuffer.executeCommands(secondarySize, secondaryBegin);
+			}
+
+			if (drawInfo.profiler && i == 0) {
+				drawInfo.profiler->endScope(commandBuffer, drawInfo.currentFrame, executeScope);
+			}
 
 			commandBuffer.endRenderPass();
 
+			if (drawInfo.profiler && i == 0) {
+				drawInfo.profiler->endScope(commandBuffer, drawInfo.currentFrame, renderPassScope);
+			}
+
 			commandBuffer.end();
 		}
 	}
@@ -214,6 +244,19 @@ public:
 		graphicsQueue.submit(submitInfo, *syncObjects.inFlightFence);
 	}
 
+	// Offscreen frames have no image acquisition to wait on, only the in flight fence is signaled.
+	template <class T>
+	void submitOffscreenDrawCommands(T begin, std::uint32_t size, const vkx::SyncObjects& syncObjects) const {
+		const vk::SubmitInfo submitInfo{
+		    0,
+		    nullptr,
+		    nullptr,
+		    size,
+		    begin};
+
+		graphicsQueue.submit(submitInfo, *syncObjects.inFlightFence);
+	}
+
 	vk::Result presentToSwapchain(const vkx::VulkanInstance::Swapchain& swapchain, std::uint32_t imageIndex, const vkx::SyncObjects& syncObjects) const;
 };
 } // namespace vkx
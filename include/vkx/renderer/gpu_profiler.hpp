@@ -0,0 +1,78 @@
+#pragma once
+
+namespace vkx {
+struct GPUTimings {
+	float minimum = 0.0f;
+	float average = 0.0f;
+	float maximum = 0.0f;
+	float latest = 0.0f;
+	std::size_t samples = 0;
+	// Every sample resolved so far, not only those inside the rolling window.
+	std::size_t resolved = 0;
+};
+
+// Timestamp queries are written into one query pool per slot. A slot is resolved
+// when it is reused, by then its fence has been waited on so reading never stalls.
+// Frames in flight own the first slots, upload batches take one of the remaining ones each.
+class GPUProfiler {
+public:
+	static constexpr std::uint32_t UPLOAD_SLOT_COUNT = 4;
+	static constexpr std::uint32_t SLOT_COUNT = vkx::MAX_FRAMES_IN_FLIGHT + UPLOAD_SLOT_COUNT;
+	static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+	static constexpr std::uint32_t NO_SCOPE = UINT32_MAX;
+	static constexpr std::size_t HISTORY_SIZE = 128;
+
+private:
+	struct Slot {
+		vk::QueryPool queryPool{};
+		std::vector<std::size_t> scopes{};
+		bool acquired = false;
+	};
+
+	struct History {
+		std::array<float, HISTORY_SIZE> samples{};
+		std::size_t count = 0;
+		std::size_t next = 0;
+		std::size_t resolved = 0;
+	};
+
+	vk::Device logicalDevice{};
+	float timestampPeriod = 0.0f;
+	std::uint64_t timestampMask = 0;
+	std::uint32_t maxScopes = 0;
+	std::vector<Slot> slots{};
+	std::vector<std::string> labels{};
+	std::vector<History> histories{};
+
+public:
+	GPUProfiler() = default;
+
+	explicit GPUProfiler(vk::PhysicalDevice physicalDevice, vk::Device logicalDevice, std::uint32_t queueFamilyIndex, std::uint32_t maxScopes = 16);
+
+	void destroy();
+
+	[[nodiscard]] bool isSupported() const noexcept;
+
+	// Must be recorded outside of a render pass before any scope of this slot.
+	void beginFrame(vk::CommandBuffer commandBuffer, std::uint32_t slot);
+
+	[[nodiscard]] std::uint32_t beginScope(vk::CommandBuffer commandBuffer, std::uint32_t slot, const char* label);
+
+	void endScope(vk::CommandBuffer commandBuffer, std::uint32_t slot, std::uint32_t scope) const;
+
+	void resolve(std::uint32_t slot);
+
+	// Overlapping upload batches must not share queries, returns NO_SLOT when every upload slot is taken.
+	[[nodiscard]] std::uint32_t acquireUploadSlot();
+
+	// Resolves the slot unless its queries were never submitted and hands it to the next upload batch.
+	void releaseUploadSlot(std::uint32_t slot, bool submitted);
+
+	[[nodiscard]] vkx::GPUTimings timings(const std::string& label) const;
+
+	[[nodiscard]] const std::vector<std::string>& getLabels() const noexcept;
+
+private:
+	[[nodiscard]] std::size_t labelIndex(const char* label);
+};
+} // namespace vkx
@@ -13,12 +13,12 @@ public:
 
 	explicit Image(vk::Device logicalDevice, VmaAllocator allocator, VkImage image, VmaAllocation allocation);
 
-	explicit Image(vk::Device logicalDevice, VmaAllocator allocator, vk::Extent2D extent, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags imageUsage, VmaAllocationCreateFlags flags, VmaMemoryUsage memoryUsage);
+	explicit Image(vk::Device logicalDevice, VmaAllocator allocator, vk::Extent2D extent, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags imageUsage, std::uint32_t mipLevels, std::uint32_t arrayLayers, VmaAllocationCreateFlags flags, VmaMemoryUsage memoryUsage);
 
 	explicit operator vk::Image() const;
 
 	void destroy() const;
 
-	vk::ImageView createView(vk::Format format, vk::ImageAspectFlags aspectFlags) const;
+	vk::ImageView createView(vk::Format format, vk::ImageAspectFlags aspectFlags, vk::ImageViewType viewType = vk::ImageViewType::e2D, std::uint32_t mipLevels = 1, std::uint32_t arrayLayers = 1) const;
 };
 } // namespace vkx
@@ -4,17 +4,71 @@
 #include <vkx/renderer/vertex.hpp>
 
 namespace vkx {
+struct MeshRange {
+	std::size_t firstVertex = 0;
+	std::size_t vertexCount = 0;
+	std::size_t firstIndex = 0;
+	std::size_t indexCount = 0;
+};
+
+// Adds a range to the list, merging it with a range starting at the same vertex and index so lists stay short.
+void mergeRange(std::vector<vkx::MeshRange>& ranges, const vkx::MeshRange& range);
+
+// Device buffers a mesh drew from before its last upload. They hold its vertices and indices up to the counts,
+// except for the stale ranges that changed since.
+struct MeshBuffers {
+	vkx::Buffer vertexBuffer{};
+	vkx::Buffer indexBuffer{};
+	std::size_t vertexCount = 0;
+	std::size_t indexCount = 0;
+	std::vector<vkx::MeshRange> staleRanges{};
+	// Frame from which on no snapshot draws the buffers anymore.
+	std::uint64_t frame = 0;
+};
+
 struct Mesh {
 	vkx::Buffer vertexBuffer{};
 	vkx::Buffer indexBuffer{};
 	std::vector<vkx::Vertex> vertices{};
 	std::vector<std::uint32_t> indices{};
 	std::size_t activeIndexCount = 0;
+	// Vertices up to the last one the active indices use.
+	std::size_t activeVertexCount = 0;
+	// Vertices and indices the device buffers hold.
+	std::size_t uploadedVertexCount = 0;
+	std::size_t uploadedIndexCount = 0;
+	// Ranges changed since the last upload, buffers that hold everything else only need these copied.
+	std::vector<vkx::MeshRange> changedRanges{};
+	// Buffers drawn before the last upload, written again instead of allocating once no frame in flight draws them.
+	std::vector<vkx::MeshBuffers> spareBuffers{};
 
 	Mesh() = default;
 
 	explicit Mesh(std::vector<vkx::Vertex>&& vertices, std::vector<std::uint32_t>&& indices, std::size_t activeIndexCount, const vkx::VulkanInstance& instance);
 
 	explicit Mesh(std::size_t vertexCount, std::size_t indexCount, const vkx::VulkanInstance& instance);
+
+	// Evicted meshes keep their vertices and indices but have no device buffers, spare buffers included.
+	[[nodiscard]] bool isResident() const;
+
+	// Allocates device buffers sized to the active vertices and indices and uploads them, returns the bytes written.
+	std::size_t makeResident(const vkx::VulkanInstance& instance);
+
+	// Copies the active vertices and indices into the device buffers, returns the bytes written. Evicted meshes write nothing.
+	std::size_t upload();
+
+	// Copies the part of a range within the active vertices and indices and the buffers, returns the bytes written.
+	std::size_t copyRange(const vkx::Buffer& vertexDestination, const vkx::Buffer& indexDestination, const vkx::MeshRange& range) const;
+
+	void destroy();
+};
+
+// What a draw needs from a resident mesh, copied so it can be handed to another thread.
+struct MeshHandle {
+	vk::Buffer vertexBuffer{};
+	vk::Buffer indexBuffer{};
+	std::uint32_t indexCount = 0;
+	// Index of the mesh, used to look up per object data.
+	std::uint32_t object = 0;
 };
 } // namespace vkx
@@ -4,6 +4,65 @@
 
 namespace vkx {
 namespace pipeline {
+static constexpr std::uint32_t VOXEL_SCALE_CONSTANT_ID = UINT32_C(0);
+static constexpr std::uint32_t RENDER_MODE_CONSTANT_ID = UINT32_C(1);
+static constexpr std::uint32_t CHUNK_SIZE_CONSTANT_ID = UINT32_C(2);
+
+enum class RenderMode : std::int32_t {
+	Textured,
+	UV
+};
+
+class SpecializationConstants {
+private:
+	std::vector<vk::SpecializationMapEntry> entries{};
+	std::vector<std::uint32_t> data{};
+
+public:
+	struct Hash {
+		std::size_t operator()(const SpecializationConstants& constants) const noexcept;
+	};
+
+	SpecializationConstants() = default;
+
+	// GLSL specialization constants are 32 bits wide, booleans must be passed as vk::Bool32.
+	template <class T>
+	SpecializationConstants& set(std::uint32_t constantID, T value) {
+		static_assert(sizeof(T) == sizeof(std::uint32_t), "Specialization constants must be 32 bits wide.");
+
+		std::uint32_t word = 0;
+		std::memcpy(&word, &value, sizeof(word));
+
+		auto iter = std::lower_bound(entries.begin(), entries.end(), constantID, [](const auto& entry, auto id) {
+			return entry.constantID < id;
+		});
+
+		const auto index = static_cast<std::size_t>(std::distance(entries.begin(), iter));
+		if (iter != entries.end() && iter->constantID == constantID) {
+			data[index] = word;
+			return *this;
+		}
+
+		entries.emplace(iter, constantID, 0, sizeof(std::uint32_t));
+		data.insert(data.begin() + index, word);
+
+		for (std::size_t i = 0; i < entries.size(); i++) {
+			entries[i] = vk::SpecializationMapEntry{entries[i].constantID, static_cast<std::uint32_t>(i * sizeof(std::uint32_t)), sizeof(std::uint32_t)};
+		}
+
+		return *this;
+	}
+
+	// The returned info points into this object and must not outlive it.
+	[[nodiscard]] vk::SpecializationInfo info() const noexcept;
+
+	[[nodiscard]] bool empty() const noexcept;
+
+	bool operator==(const SpecializationConstants& other) const;
+
+	bool operator!=(const SpecializationConstants& other) const;
+};
+
 struct GraphicsPipelineInformation {
 	const std::string vertexFile{};
 	const std::string fragmentFile{};
@@ -12,17 +71,29 @@ struct GraphicsPipelineInformation {
 	const std::vector<vk::VertexInputAttributeDescription> attributeDescriptions{};
 	const std::vector<std::size_t> uniformSizes{};
 	const std::vector<const Texture*> textures;
+	const SpecializationConstants constants{};
+	// When set the shader files name entries of this pack instead of files on disk.
+	const vkx::AssetPack* assets = nullptr;
+	// When set the table is bound as set BindlessTable::SET and draws push BindlessDrawIndices instead.
+	const vkx::BindlessTable* bindless = nullptr;
 };
 
 class GraphicsPipeline {
 public:
 	vk::Device logicalDevice{};
+	vk::RenderPass renderPass{};
+	vk::ShaderModule vertexShaderModule{};
+	vk::ShaderModule fragmentShaderModule{};
+	std::vector<vk::VertexInputBindingDescription> bindingDescriptions{};
+	std::vector<vk::VertexInputAttributeDescription> attributeDescriptions{};
 	vk::DescriptorSetLayout descriptorLayout{};
 	vk::PipelineLayout pipelineLayout{};
 	vk::Pipeline pipeline{};
 	vk::DescriptorPool descriptorPool{};
 	std::vector<vk::DescriptorSet> descriptorSets{};
+	vk::DescriptorSet bindlessSet{};
 	std::vector<std::vector<UniformBuffer>> uniforms{};
+	std::unordered_map<SpecializationConstants, vk::Pipeline, SpecializationConstants::Hash> variants{};
 
 	GraphicsPipeline() = default;
 
@@ -34,7 +105,15 @@ public:
 
 	const std::vector<UniformBuffer>& getUniformByIndex(std::size_t i) const;
 
+	// Variants share the layout and descriptor sets of this pipeline, they are created once per set of constants.
+	vk::Pipeline getVariant(const SpecializationConstants& constants);
+
 	[[nodiscard]] vk::UniqueShaderModule createShaderModule(const std::string& filename) const;
+
+	[[nodiscard]] vk::UniqueShaderModule createShaderModule(const vkx::AssetView& asset) const;
+
+private:
+	[[nodiscard]] vk::Pipeline createVariant(const SpecializationConstants& constants) const;
 };
 } // namespace pipeline
 } // namespace vkx
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vkx/renderer/allocator.hpp>
+#include <vkx/renderer/gpu_profiler.hpp>
 #include <vkx/renderer/image.hpp>
 #include <vkx/renderer/types.hpp>
 #include <vkx/renderer/sync_objects.hpp>
@@ -91,6 +92,11 @@ private:
 	vk::PhysicalDevice physicalDevice;
 	vk::Device logicalDevice;
 	float maxSamplerAnisotropy = 0;
+	bool physicalDeviceProperties2Supported = false;
+	bool memoryBudgetSupported = false;
+	bool descriptorIndexingSupported = false;
+	std::uint32_t apiVersion = VK_API_VERSION_1_0;
+	vk::Format colorFormat;
 	vk::Format depthFormat;
 	VmaAllocator allocator;
 	vk::RenderPass clearRenderPass;
@@ -104,6 +110,8 @@ private:
 		vk::RenderPass renderPass;
 		vk::SwapchainKHR swapchain;
 		vk::Extent2D imageExtent;
+		vk::Format colorFormat;
+		std::vector<vkx::Image> offscreenImages;
 		std::vector<vk::ImageView> imageViews;
 		vk::Format depthFormat;
 		vkx::Image depthImage;
@@ -112,6 +120,10 @@ private:
 
 		void recreate();
 
+		void createSwapchainImages();
+
+		void createOffscreenImages();
+
 		void destroy();
 
 		vk::ResultValue<std::uint32_t> acquireNextImage(const vkx::SyncObjects& syncObjects) const;
@@ -122,14 +134,35 @@ public:
 
 	explicit VulkanInstance(SDL_Window* window);
 
+	// Headless instances render into offscreen images of the given extent, no window, surface or swapchain is created.
+	explicit VulkanInstance(vk::Extent2D offscreenExtent);
+
+	[[nodiscard]] bool isHeadless() const noexcept;
+
+	[[nodiscard]] const Swapchain& getSwapchain() const noexcept;
+
+	void recreateSwapchain();
+
+	[[nodiscard]] vk::ResultValue<std::uint32_t> acquireNextImage(const vkx::SyncObjects& syncObjects) const;
+
 	[[nodiscard]] vk::RenderPass createRenderPass(vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eClear, vk::ImageLayout initialLayout = vk::ImageLayout::eUndefined, vk::ImageLayout finalLayout = vk::ImageLayout::ePresentSrcKHR) const;
 
 	[[nodiscard]] vk::Format findSupportedFormat(vk::ImageTiling tiling, vk::FormatFeatureFlags features, const std::vector<vk::Format>& candidates) const;
 
-	[[nodiscard]] vk::ImageView createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags) const;
+	[[nodiscard]] vk::ImageView createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags, vk::ImageViewType viewType = vk::ImageViewType::e2D, std::uint32_t mipLevels = 1, std::uint32_t arrayLayers = 1) const;
+
+	// Mipmaps are generated with linear blits, which not every format supports with optimal tiling.
+	[[nodiscard]] bool supportsLinearBlit(vk::Format format) const;
 
 	[[nodiscard]] vkx::CommandSubmitter createCommandSubmitter() const;
 
+	[[nodiscard]] vkx::GPUProfiler createGPUProfiler() const;
+
+	// True when the device has the Vulkan 1.2 descriptor indexing features bindless tables rely on.
+	[[nodiscard]] bool supportsBindless() const noexcept;
+
+	[[nodiscard]] vkx::BindlessTable createBindlessTable() const;
+
 	[[nodiscard]] vkx::pipeline::GraphicsPipeline createGraphicsPipeline(const vkx::pipeline::GraphicsPipelineInformation& information) const;
 
 	[[nodiscard]] std::vector<vkx::SyncObjects> createSyncObjects() const;
@@ -138,6 +171,14 @@ public:
 
 	void waitIdle() const;
 
+	// Budgets are estimated from the heap sizes when VK_EXT_memory_budget is unavailable.
+	[[nodiscard]] bool hasMemoryBudget() const noexcept;
+
+	[[nodiscard]] std::vector<vkx::MemoryHeapBudget> getMemoryBudgets() const;
+
+	// Lets the allocator refresh its budget once per frame instead of querying the driver on every call.
+	void setFrameIndex(std::uint32_t frameIndex) const;
+
 	void destroy();
 
 	[[nodiscard]] vkx::Buffer allocateBuffer(std::size_t memorySize,
@@ -149,12 +190,18 @@ public:
 					       vk::Format format,
 					       vk::ImageTiling tiling,
 					       vk::ImageUsageFlags imageUsage,
+					       std::uint32_t mipLevels = 1,
+					       std::uint32_t arrayLayers = 1,
 					       VmaAllocationCreateFlags flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT,
 					       VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_AUTO) const;
 
 	[[nodiscard]] std::vector<vkx::UniformBuffer> allocateUniformBuffers(std::size_t memorySize, std::size_t amount) const;
 
 private:
+	void createInstance(std::vector<const char*> instanceExtensions);
+
+	void createDevice();
+
 	[[nodiscard]] std::uint32_t ratePhysicalDevice(vk::PhysicalDevice physicalDevice) const;
 };
 } // namespace vkx
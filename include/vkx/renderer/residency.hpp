@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vkx/renderer/model.hpp>
+
+namespace vkx {
+class ResidencyManager {
+private:
+	struct PendingRelease {
+		vkx::Buffer vertexBuffer;
+		vkx::Buffer indexBuffer;
+		std::uint64_t frame;
+	};
+
+	// Fraction of a heap's budget at which meshes start to be evicted.
+	static constexpr double BUDGET_PRESSURE = 0.9;
+
+	// Frames after which spare buffers of a mesh that stopped changing are released.
+	static constexpr std::uint64_t SPARE_FRAMES = 600;
+
+	const vkx::VulkanInstance* instance = nullptr;
+	std::uint64_t ceiling = 0;
+	std::uint64_t frame = 0;
+	std::uint64_t oldestFrameInUse = 0;
+	std::vector<std::uint64_t> lastVisibleFrames{};
+	std::vector<PendingRelease> pendingReleases{};
+
+public:
+	ResidencyManager() = default;
+
+	// A ceiling of zero bytes only evicts under pressure from the driver's budget.
+	explicit ResidencyManager(const vkx::VulkanInstance& instance, std::size_t meshCount, std::uint64_t ceiling);
+
+	void markVisible(std::size_t index);
+
+	// Restores visible meshes, releases the buffers of empty ones and idle spares, evicts the least recently visible ones while memory is under pressure and releases buffers no frame in flight uses anymore.
+	// Frames count update calls, buffers evicted at or before oldestFrameInUse are no longer drawn by any frame in flight.
+	// Returns the amount of bytes uploaded to restore meshes.
+	std::size_t update(std::vector<vkx::Mesh>& meshes, std::uint64_t oldestFrameInUse);
+
+	// Writes the changed ranges of a resident mesh into a spare copy of its buffers no frame in flight draws, or a new copy with room to grow when every spare is in use or too small, and draws from that copy.
+	// Buffers frames in flight may draw are never written. Returns the amount of bytes written.
+	std::size_t reupload(vkx::Mesh& mesh);
+
+	[[nodiscard]] std::uint64_t currentFrame() const noexcept;
+
+	[[nodiscard]] std::size_t residentCount(const std::vector<vkx::Mesh>& meshes) const;
+
+	void destroy();
+
+private:
+	[[nodiscard]] bool underPressure(const std::vector<vkx::MemoryHeapBudget>& budgets, std::uint64_t pendingBytes) const;
+
+	// Queues the buffers of the mesh and its spares for release, leaving it non-resident.
+	void retire(vkx::Mesh& mesh);
+
+	// Queues the spare buffers of the mesh last drawn before the frame for release.
+	void retireSpares(vkx::Mesh& mesh, std::uint64_t before);
+
+	void release(bool all, std::uint64_t oldestFrameInUse);
+};
+} // namespace vkx
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <vkx/asset_pack.hpp>
 #include <vkx/renderer/image.hpp>
 #include <vkx/renderer/renderer.hpp>
 
 namespace vkx {
+// Every texture is a mipmapped 2D array, one layer per file.
 class Texture {
 public:
+	static constexpr vk::Format FORMAT = vk::Format::eR8G8B8A8Srgb;
+
 	vk::Device logicalDevice;
 	vkx::Image image{};
+	std::uint32_t mipLevels = 1;
+	std::uint32_t arrayLayers = 1;
 	vk::ImageView view{};
 	vk::Sampler sampler{};
 	vk::DescriptorImageInfo descriptorImageInfo{};
@@ -16,10 +22,23 @@ public:
 
 	explicit Texture(const std::string& file,
 			 const vkx::VulkanInstance& instance,
-			 const vkx::CommandSubmitter& commandSubmitter);
+			 vkx::UploadBatch& uploadBatch);
+
+	// All files must share the same dimensions.
+	explicit Texture(const std::vector<std::string>& files,
+			 const vkx::VulkanInstance& instance,
+			 vkx::UploadBatch& uploadBatch);
+
+	// Pixels are copied from the pack's mapping into staging as they are, nothing is decoded.
+	explicit Texture(const vkx::AssetView& asset,
+			 const vkx::VulkanInstance& instance,
+			 vkx::UploadBatch& uploadBatch);
 
 	void destroy();
 
 	[[nodiscard]] const vk::DescriptorImageInfo* imageInfo() const noexcept;
+
+private:
+	void upload(const vkx::VulkanInstance& instance, vkx::UploadBatch& uploadBatch, const void* pixels, std::size_t size, std::uint32_t width, std::uint32_t height);
 };
 } // namespace vkx
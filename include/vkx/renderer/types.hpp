@@ -1,9 +1,13 @@
 #pragma once
 
 namespace vkx {
+class AssetPack;
+struct AssetView;
+class BindlessTable;
 class Buffer;
 class CommandSubmitter;
 struct DrawInfo;
+class GPUProfiler;
 namespace pipeline {
 class VulkanPipeline;
 class GraphicsPipeline;
@@ -18,6 +22,7 @@ struct SwapchainInfo;
 struct SyncObjects;
 class Texture;
 class UniformBuffer;
+class UploadBatch;
 struct Vertex;
 class VulkanAllocationDeleter;
 class VulkanAllocator;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vkx/renderer/allocator.hpp>
+#include <vkx/renderer/gpu_profiler.hpp>
+
+namespace vkx {
+// Records any number of transfers into one command buffer, submitted once and tracked by a fence.
+class UploadBatch {
+private:
+	vk::Device logicalDevice{};
+	vk::CommandPool commandPool{};
+	vk::Queue graphicsQueue{};
+	vk::CommandBuffer commandBuffer{};
+	vk::Fence fence{};
+	vkx::GPUProfiler* profiler = nullptr;
+	std::uint32_t profilerSlot = vkx::GPUProfiler::NO_SLOT;
+	std::uint32_t profilerScope = vkx::GPUProfiler::NO_SCOPE;
+	std::vector<vkx::Buffer> stagingBuffers{};
+	bool submitted = false;
+	bool finished = false;
+
+public:
+	UploadBatch() = default;
+
+	explicit UploadBatch(vk::Device logicalDevice, vk::CommandPool commandPool, vk::Queue graphicsQueue, vkx::GPUProfiler* profiler);
+
+	template <class T>
+	void record(T command) const {
+		command(commandBuffer);
+	}
+
+	void transitionImageLayout(vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, std::uint32_t mipLevels = 1, std::uint32_t arrayLayers = 1) const;
+
+	// Layers are read from the buffer one after another, each tightly packed.
+	void copyBufferToImage(vk::Buffer buffer, vk::Image image, std::uint32_t width, std::uint32_t height, std::uint32_t arrayLayers = 1) const;
+
+	// Expects every level in transfer destination layout with level 0 filled, leaves every level shader readable.
+	void generateMipmaps(vk::Image image, std::uint32_t width, std::uint32_t height, std::uint32_t mipLevels, std::uint32_t arrayLayers) const;
+
+	void copyBuffer(vk::Buffer source, vk::Buffer destination, vk::DeviceSize size) const;
+
+	// The buffer is destroyed once the batch has completed.
+	void addStagingBuffer(const vkx::Buffer& buffer);
+
+	void submit();
+
+	// Polls the fence, finishing the batch when it has signaled.
+	[[nodiscard]] bool isComplete();
+
+	void wait();
+
+	void destroy();
+
+private:
+	void finish();
+
+	void releaseProfilerSlot();
+};
+} // namespace vkx
@@ -3,14 +3,15 @@
 namespace vkx {
 struct Vertex {
 	glm::vec2 pos{};
-	glm::vec2 uv{};
+	// The third component is the layer of the material's texture.
+	glm::vec3 uv{};
 
 	Vertex() = default;
 
 	Vertex(const glm::vec2& pos);
 
 	explicit Vertex(const glm::vec2& pos,
-			const glm::vec2& uv);
+			const glm::vec3& uv);
 
 	static auto getBindingDescription() noexcept {
 		std::vector<vk::VertexInputBindingDescription> bindingDescriptions{
@@ -20,11 +21,9 @@ struct Vertex {
 	}
 
 	static auto getAttributeDescriptions() noexcept {
-		constexpr auto format = vk::Format::eR32G32Sfloat;
-
 		std::vector<vk::VertexInputAttributeDescription> attributeDescriptions{
-		    {0, 0, format, offsetof(Vertex, pos)},
-		    {1, 0, format, offsetof(Vertex, uv)}};
+		    {0, 0, vk::Format::eR32G32Sfloat, offsetof(Vertex, pos)},
+		    {1, 0, vk::Format::eR32G32B32Sfloat, offsetof(Vertex, uv)}};
 
 		return attributeDescriptions;
 	}
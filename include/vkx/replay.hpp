@@ -0,0 +1,82 @@
+#pragma once
+
+namespace vkx {
+enum class InputEventType : std::uint8_t {
+	KeyDown,
+	KeyUp,
+	MouseMotion,
+	Quit,
+	MouseButtonDown,
+	MouseButtonUp
+};
+
+struct InputEvent {
+	vkx::InputEventType type = vkx::InputEventType::Quit;
+	// Milliseconds since SDL was initialized.
+	std::uint32_t timestamp = 0;
+	// Key code for key events, cursor position for mouse motion, button for mouse button events.
+	std::int32_t x = 0;
+	std::int32_t y = 0;
+
+	[[nodiscard]] SDL_Event toSDLEvent() const noexcept;
+};
+
+// Camera state is captured after input is handled and before the world is updated.
+struct InputFrame {
+	glm::vec2 cameraPosition{0};
+	glm::vec2 direction{0};
+	// Simulation ticks that ran on the frame's input, zero when the simulation skipped it.
+	std::uint32_t ticks = 1;
+	std::vector<vkx::InputEvent> events{};
+};
+
+// Frames are stored in host byte order: a "VKXR" magic and version, then per frame the event count,
+// camera position, direction and tick count followed by 13 bytes per event.
+class InputRecorder {
+private:
+	std::ofstream file{};
+	vkx::InputFrame current{};
+	bool ended = false;
+	// Written once the next frame is published and the ticks that ran on it are known.
+	vkx::InputFrame published{};
+	bool hasPublished = false;
+
+public:
+	InputRecorder() = default;
+
+	explicit InputRecorder(const std::string& path);
+
+	[[nodiscard]] bool isOpen() const;
+
+	void record(const SDL_Event& event);
+
+	void endFrame(const glm::vec2& cameraPosition, const glm::vec2& direction);
+
+	// The ended frame was handed to the simulation, the one published before it is written with the ticks that ran on it.
+	void publishFrame(std::uint32_t previousTicks);
+
+	// Writes the last published frame once the simulation stopped.
+	void finish(std::uint32_t ticks);
+
+private:
+	void write(const vkx::InputFrame& frame);
+};
+
+class InputReplayer {
+private:
+	std::vector<vkx::InputFrame> frames{};
+	std::size_t nextFrame = 0;
+
+public:
+	InputReplayer() = default;
+
+	explicit InputReplayer(const std::string& path);
+
+	[[nodiscard]] bool isOpen() const noexcept;
+
+	// Returns nullptr once every recorded frame has been replayed.
+	[[nodiscard]] const vkx::InputFrame* next() noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept;
+};
+} // namespace vkx
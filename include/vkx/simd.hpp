@@ -0,0 +1,166 @@
+#pragma once
+
+namespace vkx {
+namespace simd {
+// Thin wrappers so kernels are written once and instantiated for every register width.
+// Masks are registers with all bits of a lane set where a comparison holds.
+// SSE2 is part of every x86-64 target.
+#if defined(__x86_64__) || defined(_M_X64)
+#define VKX_SIMD_SSE2
+struct Float4 {
+	static constexpr std::size_t WIDTH = 4;
+	using Register = __m128;
+
+	static Register load(const float* data) noexcept {
+		return _mm_loadu_ps(data);
+	}
+
+	static void store(float* data, Register value) noexcept {
+		_mm_storeu_ps(data, value);
+	}
+
+	static Register set(float value) noexcept {
+		return _mm_set1_ps(value);
+	}
+
+	static Register add(Register a, Register b) noexcept {
+		return _mm_add_ps(a, b);
+	}
+
+	static Register subtract(Register a, Register b) noexcept {
+		return _mm_sub_ps(a, b);
+	}
+
+	static Register multiply(Register a, Register b) noexcept {
+		return _mm_mul_ps(a, b);
+	}
+
+	static Register less(Register a, Register b) noexcept {
+		return _mm_cmplt_ps(a, b);
+	}
+
+	static Register greater(Register a, Register b) noexcept {
+		return _mm_cmpgt_ps(a, b);
+	}
+
+	static Register bitAnd(Register a, Register b) noexcept {
+		return _mm_and_ps(a, b);
+	}
+
+	static Register bitOr(Register a, Register b) noexcept {
+		return _mm_or_ps(a, b);
+	}
+
+	// Returns b where a is not set.
+	static Register bitAndNot(Register a, Register b) noexcept {
+		return _mm_andnot_ps(a, b);
+	}
+
+	static Register select(Register mask, Register a, Register b) noexcept {
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// One bit per lane.
+	static std::uint32_t bits(Register mask) noexcept {
+		return static_cast<std::uint32_t>(_mm_movemask_ps(mask));
+	}
+
+	// Lanes whose bit of the bitset is set, index holds whole numbers and lanes outside the mask are never read.
+	static std::uint32_t testBits(const std::uint32_t* bitset, Register index, Register mask) noexcept {
+		const auto integerMask = _mm_castps_si128(mask);
+		const auto bitIndex = _mm_and_si128(_mm_cvttps_epi32(index), integerMask);
+
+		// No gathers before AVX2, the words are loaded one by one.
+		alignas(16) std::array<std::uint32_t, WIDTH> wordIndices{};
+		_mm_store_si128(reinterpret_cast<__m128i*>(wordIndices.data()), _mm_srli_epi32(bitIndex, 5));
+		const auto words = _mm_set_epi32(static_cast<int>(bitset[wordIndices[3]]), static_cast<int>(bitset[wordIndices[2]]), static_cast<int>(bitset[wordIndices[1]]), static_cast<int>(bitset[wordIndices[0]]));
+
+		// Nor variable shifts, 1 << bit is built as the float 2^bit instead. 2^31 does not fit and converts to
+		// 0x80000000, which is the wanted bit anyway.
+		const auto exponent = _mm_slli_epi32(_mm_add_epi32(_mm_and_si128(bitIndex, _mm_set1_epi32(31)), _mm_set1_epi32(127)), 23);
+		const auto bit = _mm_cvttps_epi32(_mm_castsi128_ps(exponent));
+		const auto clear = _mm_cmpeq_epi32(_mm_and_si128(words, bit), _mm_setzero_si128());
+		return bits(_mm_andnot_ps(_mm_castsi128_ps(clear), mask));
+	}
+};
+#endif
+
+// Integer gathers need AVX2, plain AVX is not enough.
+#if defined(__AVX2__)
+#define VKX_SIMD_AVX2
+struct Float8 {
+	static constexpr std::size_t WIDTH = 8;
+	using Register = __m256;
+
+	static Register load(const float* data) noexcept {
+		return _mm256_loadu_ps(data);
+	}
+
+	static void store(float* data, Register value) noexcept {
+		_mm256_storeu_ps(data, value);
+	}
+
+	static Register set(float value) noexcept {
+		return _mm256_set1_ps(value);
+	}
+
+	static Register add(Register a, Register b) noexcept {
+		return _mm256_add_ps(a, b);
+	}
+
+	static Register subtract(Register a, Register b) noexcept {
+		return _mm256_sub_ps(a, b);
+	}
+
+	static Register multiply(Register a, Register b) noexcept {
+		return _mm256_mul_ps(a, b);
+	}
+
+	static Register less(Register a, Register b) noexcept {
+		return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+	}
+
+	static Register greater(Register a, Register b) noexcept {
+		return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+	}
+
+	static Register bitAnd(Register a, Register b) noexcept {
+		return _mm256_and_ps(a, b);
+	}
+
+	static Register bitOr(Register a, Register b) noexcept {
+		return _mm256_or_ps(a, b);
+	}
+
+	// Returns b where a is not set.
+	static Register bitAndNot(Register a, Register b) noexcept {
+		return _mm256_andnot_ps(a, b);
+	}
+
+	static Register select(Register mask, Register a, Register b) noexcept {
+		return _mm256_blendv_ps(b, a, mask);
+	}
+
+	// One bit per lane.
+	static std::uint32_t bits(Register mask) noexcept {
+		return static_cast<std::uint32_t>(_mm256_movemask_ps(mask));
+	}
+
+	// Lanes whose bit of the bitset is set, index holds whole numbers and lanes outside the mask are never read.
+	static std::uint32_t testBits(const std::uint32_t* bitset, Register index, Register mask) noexcept {
+		const auto integerMask = _mm256_castps_si256(mask);
+		const auto bitIndex = _mm256_and_si256(_mm256_cvttps_epi32(index), integerMask);
+		const auto words = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(bitset), _mm256_srli_epi32(bitIndex, 5), integerMask, 4);
+		const auto bit = _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_and_si256(bitIndex, _mm256_set1_epi32(31))), _mm256_set1_epi32(1));
+		return bits(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bit, _mm256_set1_epi32(1))));
+	}
+};
+#endif
+
+#if defined(VKX_SIMD_AVX2)
+using FloatPacket = Float8;
+#elif defined(VKX_SIMD_SSE2)
+using FloatPacket = Float4;
+#endif
+} // namespace simd
+} // namespace vkx
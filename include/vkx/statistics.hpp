@@ -0,0 +1,46 @@
+#pragma once
+
+namespace vkx {
+struct FrameSample {
+	float cpuMilliseconds = 0.0f;
+	float gpuMilliseconds = 0.0f;
+	std::uint64_t chunksGenerated = 0;
+	std::uint64_t bytesUploaded = 0;
+};
+
+struct Percentiles {
+	double p50 = 0.0;
+	double p95 = 0.0;
+	double p99 = 0.0;
+};
+
+struct FrameSummary {
+	std::size_t frames = 0;
+	vkx::Percentiles cpuMilliseconds{};
+	vkx::Percentiles gpuMilliseconds{};
+	vkx::Percentiles chunksGenerated{};
+	vkx::Percentiles bytesUploaded{};
+};
+
+class FrameStatistics {
+private:
+	std::vector<vkx::FrameSample> samples{};
+
+public:
+	FrameStatistics() = default;
+
+	void add(const vkx::FrameSample& sample);
+
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	[[nodiscard]] vkx::FrameSummary summarize() const;
+};
+
+bool writeSummary(const std::string& file, const vkx::FrameSummary& summary);
+
+// Only reads files written by writeSummary.
+[[nodiscard]] vkx::FrameSummary readSummary(const std::string& file);
+
+// Returns a description of every percentile that grew by more than threshold (0.1 = 10%) over the baseline.
+[[nodiscard]] std::vector<std::string> findRegressions(const vkx::FrameSummary& baseline, const vkx::FrameSummary& current, double threshold);
+} // namespace vkx
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace vkx {
+// Fixed set of worker threads for fork join parallelism. run hands out task indices to the workers and the calling
+// thread alike and returns once every task finished, so tasks may freely read data the caller owns.
+class ThreadPool {
+private:
+	std::vector<std::thread> workers{};
+	std::mutex mutex{};
+	std::condition_variable wake{};
+	std::condition_variable finished{};
+	const std::function<void(std::size_t)>* task = nullptr;
+	std::size_t taskCount = 0;
+	std::atomic<std::size_t> nextTask{0};
+	std::size_t busyWorkers = 0;
+	std::uint64_t generation = 0;
+	bool stopping = false;
+	std::exception_ptr error{};
+
+public:
+	// Only the calling thread runs tasks.
+	ThreadPool() = default;
+
+	// threadCount includes the calling thread, zero uses every hardware thread.
+	explicit ThreadPool(std::size_t threadCount);
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool();
+
+	// Threads tasks are spread over, the calling thread included.
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	// Calls task(i) for every i below count and waits for all of them, the first exception thrown is rethrown here.
+	void run(std::size_t count, const std::function<void(std::size_t)>& newTask);
+
+private:
+	void work();
+
+	// Takes task indices until none are left.
+	void drain() noexcept;
+};
+} // namespace vkx
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace vkx {
+// Hands the latest value from one writer thread to one reader thread without locks.
+// Each side owns a slot, publishing and acquiring swap it with the shared middle slot, so neither ever waits on the other.
+template <class T>
+class TripleBuffer {
+private:
+	static constexpr std::uint8_t INDEX_MASK = 0b011;
+	// Set on the middle slot while it holds a value the reader has not acquired yet.
+	static constexpr std::uint8_t FRESH_BIT = 0b100;
+
+	std::array<T, 3> slots{};
+	std::uint8_t writeIndex = 0;
+	std::atomic<std::uint8_t> middle{1};
+	std::uint8_t readIndex = 2;
+
+public:
+	TripleBuffer() = default;
+
+	// The slot may hold any earlier value, writers overwrite all of it before publishing.
+	[[nodiscard]] T& write() noexcept {
+		return slots[writeIndex];
+	}
+
+	void publish() noexcept {
+		writeIndex = middle.exchange(static_cast<std::uint8_t>(writeIndex | FRESH_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	// Returns false and keeps the current value when nothing was published since the last acquire.
+	bool acquire() noexcept {
+		if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+			return false;
+		}
+
+		readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+
+	[[nodiscard]] const T& read() const noexcept {
+		return slots[readIndex];
+	}
+};
+} // namespace vkx
@@ -1,7 +1,14 @@
 #pragma once
 
 #include <vkx/camera.hpp>
+#include <vkx/ecs/archetype.hpp>
+#include <vkx/ecs/scheduler.hpp>
+#include <vkx/ecs/world.hpp>
+#include <vkx/physics/physics_world.hpp>
+#include <vkx/physics/spatial_hash.hpp>
+#include <vkx/physics/voxel_collision.hpp>
 #include <vkx/raycast.hpp>
+#include <vkx/raycast_packet.hpp>
 #include <vkx/renderer/buffers.hpp>
 #include <vkx/renderer/commands.hpp>
 #include <vkx/renderer/image.hpp>
@@ -9,5 +16,14 @@
 #include <vkx/renderer/renderer.hpp>
 #include <vkx/renderer/swapchain.hpp>
 #include <vkx/renderer/texture.hpp>
+#include <vkx/thread_pool.hpp>
+#include <vkx/voxels/chunk_layout.hpp>
+#include <vkx/voxels/chunk_scheduler.hpp>
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/edit_queue.hpp>
+#include <vkx/voxels/field_of_view.hpp>
+#include <vkx/voxels/occupancy_grid.hpp>
+#include <vkx/voxels/region_edit.hpp>
 #include <vkx/voxels/voxels.hpp>
+#include <vkx/voxels/world_raycast.hpp>
 #include <vkx/window.hpp>
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace vkx {
+// Where voxel x, y of a Width by Height chunk is stored.
+struct RowMajorLayout {
+	// Spans of a row are consecutive, so they can be filled and copied in one go.
+	static constexpr bool CONSECUTIVE_ROWS = true;
+
+	template <std::size_t Width, std::size_t Height>
+	[[nodiscard]] static constexpr std::size_t index(std::size_t x, std::size_t y) noexcept {
+		return x + y * Width;
+	}
+};
+
+// Z-order, the bits of x and y interleaved, so voxels that are close in both axes are close in memory.
+struct MortonLayout {
+	static constexpr bool CONSECUTIVE_ROWS = false;
+
+	template <std::size_t Width, std::size_t Height>
+	[[nodiscard]] static constexpr std::size_t index(std::size_t x, std::size_t y) noexcept {
+		static_assert(Width == Height && (Width & (Width - 1)) == 0, "Morton layouts need square chunks with a power of two size.");
+
+		return spreadBits(x) | (spreadBits(y) << 1);
+	}
+
+	// Moves bit i of the low 16 bits to bit 2 * i.
+	[[nodiscard]] static constexpr std::size_t spreadBits(std::size_t value) noexcept {
+		value &= 0xFFFF;
+		value = (value | (value << 8)) & 0x00FF00FF;
+		value = (value | (value << 4)) & 0x0F0F0F0F;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+		return value;
+	}
+};
+} // namespace vkx
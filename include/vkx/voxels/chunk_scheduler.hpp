@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vkx/renderer/residency.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+enum class ChunkStage : std::uint8_t {
+	Generate,
+	Mesh,
+	Upload,
+	Ready
+};
+
+struct ChunkWork {
+	std::size_t chunksGenerated = 0;
+	std::size_t bytesUploaded = 0;
+};
+
+// Rebuilds chunks one stage at a time, most urgent first, within a time budget or a job limit per run.
+// Chunks in view come first, then the ones closest to the camera.
+class ChunkScheduler {
+private:
+	struct Job {
+		std::size_t slot = 0;
+		// Jobs queued before their slot was scheduled again are cancelled.
+		std::uint64_t generation = 0;
+		vkx::ChunkStage stage = vkx::ChunkStage::Generate;
+		bool visible = false;
+		float distance = 0.0f;
+	};
+
+	std::vector<Job> queue{};
+	std::vector<std::uint64_t> generations{};
+	std::vector<vkx::ChunkStage> stages{};
+
+public:
+	ChunkScheduler() = default;
+
+	explicit ChunkScheduler(std::size_t slotCount);
+
+	// The slot holds a new chunk, work still queued for its previous one is dropped.
+	void schedule(std::size_t slot);
+
+	// False while the slot's mesh still shows its previous chunk.
+	[[nodiscard]] bool isReady(std::size_t slot) const noexcept;
+
+	[[nodiscard]] std::size_t pendingCount() const noexcept;
+
+	// Runs jobs until the queue is empty or the budget is spent, at least one job runs so work always progresses.
+	// A job limit other than zero replaces the budget, so runs do the same work however long jobs take.
+	// Visible slots must be sorted. Resident meshes are uploaded through the residency manager.
+	vkx::ChunkWork run(std::vector<vkx::VoxelChunk2D>& chunks,
+			   std::vector<vkx::Mesh>& meshes,
+			   vkx::ResidencyManager& residency,
+			   const std::vector<std::size_t>& visibleSlots,
+			   const glm::vec2& cameraPosition,
+			   std::chrono::duration<double> budget,
+			   std::size_t jobLimit);
+};
+} // namespace vkx
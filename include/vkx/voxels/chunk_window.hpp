@@ -0,0 +1,44 @@
+#pragma once
+
+namespace vkx {
+// Chunk coordinate holding a global voxel position.
+[[nodiscard]] glm::ivec2 chunkCoordinate(const glm::vec2& globalPosition) noexcept;
+
+// Square window of loaded chunks that follows the camera. Every chunk coordinate maps to one slot
+// by wrapping it around the window, so moving by a chunk only reassigns the slots of one row or column.
+class ChunkWindow {
+public:
+	// Ticks of camera velocity the window reaches ahead, so chunks are generated before they come into view.
+	static constexpr float PREFETCH_TICKS = 30.0f;
+
+	// Every slot keeps a full size mesh on the CPU, a window this wide already holds over a thousand of them.
+	static constexpr std::int32_t MAX_RADIUS = 16;
+
+private:
+	std::int32_t radius = 0;
+	std::int32_t width = 0;
+	glm::ivec2 origin{0};
+	std::vector<glm::ivec2> coordinates{};
+
+public:
+	// Without a radius there would be no slot for any chunk to wrap onto.
+	ChunkWindow() = delete;
+
+	// Holds radius chunks on each side of the center, the center's chunk included.
+	explicit ChunkWindow(std::int32_t radius, const glm::ivec2& center);
+
+	[[nodiscard]] std::int32_t getRadius() const noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	[[nodiscard]] std::size_t slot(const glm::ivec2& chunk) const noexcept;
+
+	[[nodiscard]] glm::ivec2 coordinate(std::size_t slot) const;
+
+	[[nodiscard]] bool contains(const glm::ivec2& chunk) const noexcept;
+
+	// Recenters ahead of the camera in the direction of its velocity, in voxels per tick.
+	// The camera's own chunk and its neighbours always stay inside. Slots that now hold another chunk are written to changed.
+	void move(const glm::vec2& cameraPosition, const glm::vec2& velocity, std::vector<std::size_t>& changed);
+};
+} // namespace vkx
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vkx/voxels/chunk_scheduler.hpp>
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+struct VoxelEdit {
+	// Global voxel position.
+	glm::ivec2 position{0};
+	vkx::Voxel voxel = vkx::Voxel::Air;
+};
+
+// Collects voxel edits between ticks, so every chunk they touch is remeshed once however many edits it got.
+class EditQueue {
+private:
+	std::vector<vkx::VoxelEdit> edits{};
+
+public:
+	EditQueue() = default;
+
+	void push(const glm::ivec2& position, vkx::Voxel voxel);
+
+	[[nodiscard]] std::size_t size() const noexcept;
+
+	// Applies the edits in the order they were pushed, so the last edit of a voxel wins, and fills touched with
+	// every slot whose voxels changed. Edits of chunks still being built wait for them, edits outside the window are dropped.
+	void apply(const vkx::ChunkWindow& window, std::vector<vkx::VoxelChunk2D>& chunks, const vkx::ChunkScheduler& scheduler, std::vector<std::size_t>& touched);
+};
+} // namespace vkx
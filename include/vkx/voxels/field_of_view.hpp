@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+// Cells visible from a point, found with symmetric shadowcasting: every quadrant is scanned row by row outwards and
+// split wherever a wall starts or ends, so only visible cells and the walls bounding them are ever touched.
+// A cell is visible from the origin exactly when the origin is visible from the cell.
+class FieldOfView {
+private:
+	// Slope of a line through the origin as a fraction, so shadows line up exactly with cell corners.
+	struct Slope {
+		std::int64_t numerator = 0;
+		std::int64_t denominator = 1;
+	};
+
+	glm::ivec2 origin{0};
+	std::int32_t radius = 0;
+	glm::ivec2 minChunk{0};
+	glm::ivec2 chunkCount{0};
+	// Visible bits per chunk of the square around the origin, laid out like VoxelChunk2D::rowOccupancy.
+	std::vector<std::array<std::uint32_t, vkx::CHUNK_SIZE>> visibleRows{};
+
+public:
+	FieldOfView() = default;
+
+	// Recomputes the cells visible from origin up to radius voxels away. lookup(chunkCoordinate) returns the chunk or
+	// nullptr when it is not loaded, voxels that are not air block sight and unloaded chunks are treated as air.
+	// Walls bounding the visible area are visible themselves.
+	template <class Lookup>
+	void compute(const glm::ivec2& newOrigin, std::int32_t newRadius, Lookup lookup) {
+		reset(newOrigin, newRadius);
+		reveal(origin);
+
+		constexpr auto chunkSize = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+		// The last chunk looked up, neighbouring cells almost always share it.
+		glm::ivec2 cachedChunk{std::numeric_limits<std::int32_t>::max()};
+		const vkx::VoxelChunk2D* cached = nullptr;
+
+		const auto isWall = [&](const glm::ivec2& cell) {
+			const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+			if (chunkPosition != cachedChunk) {
+				cachedChunk = chunkPosition;
+				cached = lookup(chunkPosition);
+			}
+
+			if (!cached) {
+				return false;
+			}
+
+			const auto local = cell - chunkPosition * chunkSize;
+			return ((cached->rowOccupancy[static_cast<std::size_t>(local.y)] >> local.x) & 1) != 0;
+		};
+
+		// Maps depth along the quadrant's axis and column across it to a cell.
+		const std::array<glm::ivec2, 4> forwards{glm::ivec2{0, -1}, glm::ivec2{1, 0}, glm::ivec2{0, 1}, glm::ivec2{-1, 0}};
+		for (const auto& forward : forwards) {
+			const glm::ivec2 across{-forward.y, forward.x};
+			const auto transform = [&](std::int32_t depth, std::int32_t column) {
+				return origin + forward * depth + across * column;
+			};
+
+			scan(1, Slope{-1, 1}, Slope{1, 1}, transform, isWall);
+		}
+	}
+
+	[[nodiscard]] bool isVisible(const glm::ivec2& cell) const noexcept;
+
+	// Visible bits of the chunk at the chunk coordinate, nullptr when the chunk is out of reach of the last compute.
+	[[nodiscard]] const std::array<std::uint32_t, vkx::CHUNK_SIZE>* chunkVisibility(const glm::ivec2& chunkPosition) const noexcept;
+
+private:
+	// Clears the bitsets, reusing their storage, and covers the square of radius around the origin.
+	void reset(const glm::ivec2& newOrigin, std::int32_t newRadius);
+
+	// Marks a cell visible if it lies within the radius.
+	void reveal(const glm::ivec2& cell) noexcept;
+
+	[[nodiscard]] static std::int32_t floorDivide(std::int64_t numerator, std::int64_t denominator) noexcept;
+
+	// Scans one row of a quadrant between the start and end slopes and recurses into the rows behind it.
+	template <class Transform, class IsWall>
+	void scan(std::int32_t depth, Slope start, Slope end, const Transform& transform, const IsWall& isWall) {
+		if (depth > radius) {
+			return;
+		}
+
+		// Columns whose centers lie within the slopes, ties rounded towards the inside.
+		const auto minColumn = floorDivide(2 * depth * start.numerator + start.denominator, 2 * start.denominator);
+		const auto maxColumn = -floorDivide(end.denominator - 2 * depth * end.numerator, 2 * end.denominator);
+
+		// Floors only count as visible when their center is inside the slopes, which is what makes the result symmetric.
+		const auto isSymmetric = [&](std::int32_t column) {
+			return column * start.denominator >= depth * start.numerator && column * end.denominator <= depth * end.numerator;
+		};
+
+		// Slope through the near corner of a column, where shadows start and end.
+		const auto slope = [depth](std::int32_t column) {
+			return Slope{2 * static_cast<std::int64_t>(column) - 1, 2 * static_cast<std::int64_t>(depth)};
+		};
+
+		auto hasPrevious = false;
+		auto previousWall = false;
+		for (auto column = minColumn; column <= maxColumn; column++) {
+			const auto cell = transform(depth, column);
+			const auto wall = isWall(cell);
+
+			if (wall || isSymmetric(column)) {
+				reveal(cell);
+			}
+
+			if (hasPrevious && previousWall && !wall) {
+				start = slope(column);
+			}
+
+			if (hasPrevious && !previousWall && wall) {
+				scan(depth + 1, start, slope(column), transform, isWall);
+			}
+
+			hasPrevious = true;
+			previousWall = wall;
+		}
+
+		if (hasPrevious && !previousWall) {
+			scan(depth + 1, start, end, transform, isWall);
+		}
+	}
+};
+} // namespace vkx
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+// One bit per voxel over a rectangle of whole chunks, set where the voxel is not air.
+// Flat and branch free to test, so many rays can be cast against it at once.
+class OccupancyGrid {
+private:
+	glm::ivec2 origin{0};
+	std::int32_t width = 0;
+	std::int32_t height = 0;
+	std::vector<std::uint32_t> bitset{};
+
+public:
+	OccupancyGrid() = default;
+
+	// Covers chunksWide by chunksHigh chunks starting at the chunk coordinate minChunk, all air.
+	explicit OccupancyGrid(const glm::ivec2& minChunk, std::int32_t chunksWide, std::int32_t chunksHigh);
+
+	// Global voxel position of bit zero.
+	[[nodiscard]] glm::ivec2 getOrigin() const noexcept;
+
+	[[nodiscard]] std::int32_t getWidth() const noexcept;
+
+	[[nodiscard]] std::int32_t getHeight() const noexcept;
+
+	// Bit x + y * width is the voxel at origin + (x, y).
+	[[nodiscard]] const std::uint32_t* data() const noexcept;
+
+	// Voxels outside the grid are air.
+	[[nodiscard]] bool isSolid(const glm::ivec2& globalPosition) const noexcept;
+
+	// Copies the occupancy bits of the chunk at the chunk coordinate, chunks outside the grid are ignored.
+	void copyChunk(const glm::ivec2& chunkPosition, const vkx::VoxelChunk2D& chunk);
+};
+} // namespace vkx
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vkx/voxels/chunk_scheduler.hpp>
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+// Rectangle of voxels stamped as is, air included.
+struct VoxelPrefab {
+	glm::ivec2 size{0};
+	// Row major, size.x * size.y voxels.
+	std::vector<vkx::Voxel> voxels{};
+};
+
+// Edits regions of global voxel positions that may cross chunks. Regions are split into spans of rows per chunk
+// and written a span at a time, chunks outside the window or still being built are left alone. Every slot whose
+// voxels changed is appended to touched once, so the caller remeshes each of them once after all edits.
+class RegionEditor {
+private:
+	const vkx::ChunkWindow* window = nullptr;
+	std::vector<vkx::VoxelChunk2D>* chunks = nullptr;
+	const vkx::ChunkScheduler* scheduler = nullptr;
+	std::vector<std::size_t>* touched = nullptr;
+	std::vector<glm::ivec2> seeds{};
+
+public:
+	RegionEditor() = default;
+
+	explicit RegionEditor(const vkx::ChunkWindow& window, std::vector<vkx::VoxelChunk2D>& chunks, const vkx::ChunkScheduler& scheduler, std::vector<std::size_t>& touched);
+
+	// Fills voxels minX up to maxX of row y.
+	void fillSpan(std::int32_t y, std::int32_t minX, std::int32_t maxX, vkx::Voxel voxel);
+
+	// Fills min up to max.
+	void fillRect(const glm::ivec2& min, const glm::ivec2& max, vkx::Voxel voxel);
+
+	// Fills every voxel whose center is within radius of the center voxel's center.
+	void fillCircle(const glm::ivec2& center, std::int32_t radius, vkx::Voxel voxel);
+
+	// Copies the prefab with its first voxel at position.
+	void stamp(const glm::ivec2& position, const vkx::VoxelPrefab& prefab);
+
+	// Replaces the voxels connected to start by an edge that match it, up to limit of them, returns how many were replaced.
+	std::size_t floodFill(const glm::ivec2& start, vkx::Voxel voxel, std::size_t limit);
+
+private:
+	[[nodiscard]] vkx::VoxelChunk2D* readyChunk(const glm::ivec2& chunk) const;
+
+	// False when the voxel is not the target or its chunk cannot be edited.
+	[[nodiscard]] bool matches(const glm::ivec2& position, vkx::Voxel target) const;
+
+	void touch(const glm::ivec2& chunk);
+};
+} // namespace vkx
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <vkx/profiler.hpp>
 #include <vkx/renderer/model.hpp>
+#include <vkx/voxels/chunk_layout.hpp>
 
 namespace vkx {
 enum class Voxel : std::int32_t {
@@ -9,6 +11,11 @@ enum class Voxel : std::int32_t {
 	Dirt
 };
 
+// Layer of the material texture array a voxel samples, air is never meshed and has none.
+[[nodiscard]] constexpr std::uint32_t materialLayer(Voxel voxel) noexcept {
+	return static_cast<std::uint32_t>(voxel) - 1;
+}
+
 struct VoxelMask {
 	Voxel voxel = Voxel::Air;
 	std::int32_t normal = 0;
@@ -24,31 +31,457 @@ struct VoxelMask {
 
 static constexpr std::size_t CHUNK_SIZE = 32;
 
-static constexpr float CHUNK_RADIUS = 5.0f;
+static constexpr float VOXEL_SCALE = 16.0f;
+
+// Meshes are split into bands of rows, each with its own range of the vertices and indices, so an edit only remeshes its band.
+static constexpr std::size_t MESH_BANDS = 4;
+
+// Writes the two triangles of a quad whose first corner is at position, returns the vertex count after them.
+std::uint32_t createQuad(std::vector<vkx::Vertex>::iterator vertexIter, std::vector<std::uint32_t>::iterator indexIter, std::uint32_t vertexCount, std::int32_t width, std::int32_t height, const glm::vec2& position, float layer);
 
-static constexpr float CHUNK_HALF_RADIUS = CHUNK_RADIUS / 2.0f;
+// Chunk of Width by Height voxels stored in the order Layout gives them. The world uses VoxelChunk2D,
+// other dimensions and layouts exist to be measured against it.
+template <std::size_t Width, std::size_t Height, class Layout = vkx::RowMajorLayout>
+struct BasicVoxelChunk2D {
+	static constexpr std::size_t WIDTH = Width;
+	static constexpr std::size_t HEIGHT = Height;
+	static constexpr std::size_t VOLUME = Width * Height;
+	static constexpr std::size_t BAND_ROWS = Height / MESH_BANDS;
+	static constexpr std::size_t BAND_QUADS = BAND_ROWS * Width;
+	// Mesh storage for the worst case of one quad per voxel.
+	static constexpr std::size_t MAX_VERTICES = VOLUME * 4;
+	static constexpr std::size_t MAX_INDICES = VOLUME * 6;
+	// Occupancy bits of a row without air and of a chunk without empty rows.
+	static constexpr std::uint32_t FULL_ROW = ~std::uint32_t{0} >> (32 - Width);
+	static constexpr std::uint32_t ALL_ROWS = ~std::uint32_t{0} >> (32 - Height);
+
+	// A row of a chunk is tracked as one occupancy word.
+	static_assert(Width > 0 && Width <= 32 && Height > 0 && Height <= 32);
+	static_assert(Height % MESH_BANDS == 0);
 
-struct VoxelChunk2D {
 	glm::vec2 globalPosition;
+	// Written through set or the generators, which keep the occupancy bits in sync.
+	// Empty while the chunk is uniform, every voxel is uniformVoxel then.
 	std::vector<vkx::Voxel> voxels;
+	vkx::Voxel uniformVoxel = vkx::Voxel::Air;
+	// Bit x of row y is set when the voxel at x, y is not air.
+	std::array<std::uint32_t, Height> rowOccupancy{};
+	// Bit y is set when row y has any voxel that is not air.
+	std::uint32_t occupiedRows = 0;
+	// Bit y is set when row y changed since the chunk was last meshed.
+	std::uint32_t dirtyRows = 0;
+	// Indices each band had when it was last meshed, the rest of its range is degenerate.
+	std::array<std::uint32_t, MESH_BANDS> bandIndexCounts{};
 
-	explicit VoxelChunk2D(const glm::vec2& chunkPosition);
+	explicit BasicVoxelChunk2D(const glm::vec2& chunkPosition)
+	    : globalPosition(chunkPosition * glm::vec2{static_cast<float>(Width), static_cast<float>(Height)}) {}
 
-	void generateTerrain();
+	// Position of voxel x, y in voxels.
+	[[nodiscard]] static constexpr std::size_t index(std::size_t x, std::size_t y) noexcept {
+		return Layout::template index<Width, Height>(x, y);
+	}
 
-	void generateTestBox();
+	void generateTerrain() {
+		VKX_PROFILE_ZONE("generateTerrain");
 
-	void generateMesh(vkx::Mesh& mesh);
+		voxels.resize(VOLUME);
+		for (std::size_t x = 0; x < Width; x++) {
+			for (std::size_t y = 0; y < Height; y++) {
+				const auto global = globalPosition + glm::vec2(x, y);
+				const auto height = (glm::simplex(global) + 1.0f) / 2.0f;
 
-	[[nodiscard]] vkx::Voxel at(std::size_t i) const;
+				auto voxel = vkx::Voxel::Air;
 
-	void set(std::size_t i, vkx::Voxel voxel);
+				if (height < 0.5f) {
+					voxel = vkx::Voxel::Stone;
+				}
 
-	std::uint32_t createQuad(std::vector<vkx::Vertex>::iterator vertexIter, std::vector<std::uint32_t>::iterator indexIter, std::uint32_t vertexCount, std::int32_t width, std::int32_t height, const glm::vec2& pos) const;
-};
+				voxels[index(x, y)] = voxel;
+			}
+		}
+
+		updateOccupancy();
+
+		// Sky and deep rock chunks keep a single voxel.
+		compact();
+	}
+
+	void generateTestBox() {
+		voxels.resize(VOLUME);
+		for (std::size_t x = 0; x < Width; x++) {
+			for (std::size_t y = 0; y < Height; y++) {
+				if (x > Width / 2) {
+					voxels[index(x, y)] = vkx::Voxel::Stone;
+				} else {
+					voxels[index(x, y)] = vkx::Voxel::Dirt;
+				}
+			}
+		}
+
+		updateOccupancy();
+	}
+
+	// Meshes into the kept vertices and indices only and marks all of them changed, ResidencyManager::reupload copies them to the device.
+	void generateMesh(vkx::Mesh& mesh) {
+		VKX_PROFILE_ZONE("generateMesh");
+
+		mesh.activeIndexCount = generateQuads(mesh.vertices, mesh.indices);
+		mesh.activeVertexCount = activeVertexCount();
+		mesh.changedRanges.clear();
+		mesh.changedRanges.push_back({0, mesh.vertices.size(), 0, mesh.indices.size()});
+	}
+
+	// Greedy meshes every band into preallocated storage of MAX_VERTICES and MAX_INDICES, returns the amount of indices to draw.
+	std::size_t generateQuads(std::vector<vkx::Vertex>& vertices, std::vector<std::uint32_t>& indices) {
+		for (std::size_t band = 0; band < MESH_BANDS; band++) {
+			const auto indexCount = generateBand(band, vertices, indices);
+
+			// Draws cover every band up to the last one with quads, the unused rest of each range must not draw anything.
+			const auto firstIndex = indices.begin() + band * BAND_QUADS * 6;
+			std::fill(firstIndex + indexCount, firstIndex + BAND_QUADS * 6, static_cast<std::uint32_t>(band * BAND_QUADS * 4));
+			bandIndexCounts[band] = static_cast<std::uint32_t>(indexCount);
+		}
+
+		dirtyRows = 0;
+
+		return activeIndexCount();
+	}
+
+	// Greedy meshes one band into its range of the storage, returns the amount of indices written there.
+	std::size_t generateBand(std::size_t band, std::vector<vkx::Vertex>& vertices, std::vector<std::uint32_t>& indices) const {
+		constexpr auto width = static_cast<std::int32_t>(Width);
+		constexpr auto bandRows = static_cast<std::int32_t>(BAND_ROWS);
+
+		const auto firstRow = static_cast<std::int32_t>(band * BAND_ROWS);
+		const auto firstIndex = indices.begin() + band * BAND_QUADS * 6;
+		auto vertexIter = vertices.begin() + band * BAND_QUADS * 4;
+		auto indexIter = firstIndex;
+		auto vertexCount = static_cast<std::uint32_t>(band * BAND_QUADS * 4);
+
+		// A uniform chunk is a single quad, kept in the first band.
+		if (isUniform()) {
+			if (uniformVoxel == vkx::Voxel::Air || band != 0) {
+				return 0;
+			}
+
+			vkx::createQuad(vertexIter, indexIter, vertexCount, width, static_cast<std::int32_t>(Height), globalPosition, static_cast<float>(vkx::materialLayer(uniformVoxel)));
+			return 6;
+		}
+
+		// The mask is row major whatever the layout of the voxels.
+		std::array<vkx::VoxelMask, BAND_QUADS> voxelMask{};
+		for (std::size_t y = 0; y < BAND_ROWS; y++) {
+			for (std::size_t x = 0; x < Width; x++) {
+				const auto voxel = voxels[index(x, y + static_cast<std::size_t>(firstRow))];
+				voxelMask[x + y * Width] = vkx::VoxelMask{voxel, voxel != vkx::Voxel::Air};
+			}
+		}
+
+		auto n = 0;
+		for (auto y = 0; y < bandRows; y++) {
+			for (auto x = 0; x < width;) {
+				if (voxelMask[n].normal != 0) {
+					const auto& currentMask = voxelMask[n];
+
+					auto quadWidth = 1;
+					for (; x + quadWidth < width && voxelMask[n + quadWidth] == currentMask; quadWidth++) {
+					}
+
+					auto quadHeight = 1;
+					auto done = false;
+					for (; y + quadHeight < bandRows; quadHeight++) {
+						for (auto i = 0; i < quadWidth; i++) {
+							if (voxelMask[n + i + quadHeight * width] != currentMask) {
+								done = true;
+								break;
+							}
+						}
+
+						if (done) {
+							break;
+						}
+					}
+
+					vertexCount = vkx::createQuad(vertexIter, indexIter, vertexCount, quadWidth, quadHeight, globalPosition + glm::vec2{x, y + firstRow}, static_cast<float>(vkx::materialLayer(currentMask.voxel)));
+					std::advance(vertexIter, 4);
+					std::advance(indexIter, 6);
+
+					for (auto j = 0; j < quadHeight; j++) {
+						for (auto i = 0; i < quadWidth; i++) {
+							voxelMask[n + i + j * width] = vkx::VoxelMask{vkx::Voxel::Air, false};
+						}
+					}
+
+					x += quadWidth;
+					n += quadWidth;
+				} else {
+					x++;
+					n++;
+				}
+			}
+		}
+
+		return static_cast<std::size_t>(std::distance(firstIndex, indexIter));
+	}
+
+	// Remeshes only the bands with dirty rows into the kept vertices and indices and records their ranges, ResidencyManager::reupload copies just those.
+	void remesh(vkx::Mesh& mesh) {
+		VKX_PROFILE_ZONE("remesh");
+
+		compact();
+
+		for (std::size_t band = 0; band < MESH_BANDS; band++) {
+			const auto bandRows = ((std::uint32_t{1} << BAND_ROWS) - 1) << (band * BAND_ROWS);
+			if ((dirtyRows & bandRows) == 0) {
+				continue;
+			}
+
+			const auto indexCount = generateBand(band, mesh.vertices, mesh.indices);
+			const std::size_t previousCount = bandIndexCounts[band];
+
+			// Quads the band lost become degenerate, everything past them already is.
+			const auto firstIndex = mesh.indices.begin() + band * BAND_QUADS * 6;
+			if (indexCount < previousCount) {
+				std::fill(firstIndex + indexCount, firstIndex + previousCount, static_cast<std::uint32_t>(band * BAND_QUADS * 4));
+			}
+
+			bandIndexCounts[band] = static_cast<std::uint32_t>(indexCount);
+			vkx::mergeRange(mesh.changedRanges, {band * BAND_QUADS * 4, indexCount / 6 * 4, band * BAND_QUADS * 6, std::max(indexCount, previousCount)});
+		}
+
+		dirtyRows = 0;
+		mesh.activeIndexCount = activeIndexCount();
+		mesh.activeVertexCount = activeVertexCount();
+	}
+
+	[[nodiscard]] bool isDirty() const noexcept {
+		return dirtyRows != 0;
+	}
+
+	// Indices up to the end of the last band with quads.
+	[[nodiscard]] std::size_t activeIndexCount() const noexcept {
+		for (auto band = MESH_BANDS; band > 0; band--) {
+			if (bandIndexCounts[band - 1] != 0) {
+				return (band - 1) * BAND_QUADS * 6 + bandIndexCounts[band - 1];
+			}
+		}
+
+		return 0;
+	}
+
+	// Vertices up to the last quad of the last band with quads.
+	[[nodiscard]] std::size_t activeVertexCount() const noexcept {
+		for (auto band = MESH_BANDS; band > 0; band--) {
+			if (bandIndexCounts[band - 1] != 0) {
+				return (band - 1) * BAND_QUADS * 4 + bandIndexCounts[band - 1] / 6 * 4;
+			}
+		}
+
+		return 0;
+	}
 
-class ChunkLoader {
-public:
-	ChunkLoader() = default;
+	// Voxels outside the chunk are air.
+	[[nodiscard]] vkx::Voxel at(std::size_t x, std::size_t y) const {
+		if (x < Width && y < Height) {
+			return isUniform() ? uniformVoxel : voxels[index(x, y)];
+		}
+
+		return vkx::Voxel::Air;
+	}
+
+	// Voxels outside the chunk are ignored.
+	void set(std::size_t x, std::size_t y, vkx::Voxel voxel) {
+		if (x < Width && y < Height) {
+			if (isUniform()) {
+				if (voxel == uniformVoxel) {
+					return;
+				}
+
+				expand();
+			}
+
+			voxels[index(x, y)] = voxel;
+
+			const auto bit = std::uint32_t{1} << x;
+			if (voxel != vkx::Voxel::Air) {
+				rowOccupancy[y] |= bit;
+			} else {
+				rowOccupancy[y] &= ~bit;
+			}
+
+			updateRow(y);
+		}
+	}
+
+	// Fills voxels minX up to maxX of row y, returns false when they already were the voxel.
+	bool fillRow(std::size_t y, std::size_t minX, std::size_t maxX, vkx::Voxel voxel) {
+		if (isUniform()) {
+			if (voxel == uniformVoxel) {
+				return false;
+			}
+
+			expand();
+		}
+
+		if constexpr (Layout::CONSECUTIVE_ROWS) {
+			const auto begin = voxels.begin() + index(0, y);
+			if (std::all_of(begin + minX, begin + maxX, [voxel](vkx::Voxel current) { return current == voxel; })) {
+				return false;
+			}
+
+			std::fill(begin + minX, begin + maxX, voxel);
+		} else {
+			auto changed = false;
+			for (auto x = minX; x < maxX; x++) {
+				changed |= voxels[index(x, y)] != voxel;
+				voxels[index(x, y)] = voxel;
+			}
+
+			if (!changed) {
+				return false;
+			}
+		}
+
+		const auto bits = spanBits(minX, maxX);
+		rowOccupancy[y] = voxel != vkx::Voxel::Air ? rowOccupancy[y] | bits : rowOccupancy[y] & ~bits;
+		updateRow(y);
+
+		return true;
+	}
+
+	// Copies count voxels into row y starting at x, returns false when none of them changed.
+	bool copyRow(std::size_t y, std::size_t x, const vkx::Voxel* source, std::size_t count) {
+		if (isUniform()) {
+			if (std::all_of(source, source + count, [this](vkx::Voxel voxel) { return voxel == uniformVoxel; })) {
+				return false;
+			}
+
+			expand();
+		}
+
+		if constexpr (Layout::CONSECUTIVE_ROWS) {
+			const auto begin = voxels.begin() + index(x, y);
+			if (std::equal(source, source + count, begin)) {
+				return false;
+			}
+
+			std::copy(source, source + count, begin);
+		} else {
+			auto changed = false;
+			for (std::size_t i = 0; i < count; i++) {
+				changed |= voxels[index(x + i, y)] != source[i];
+				voxels[index(x + i, y)] = source[i];
+			}
+
+			if (!changed) {
+				return false;
+			}
+		}
+
+		std::uint32_t bits = 0;
+		for (std::size_t i = 0; i < count; i++) {
+			if (source[i] != vkx::Voxel::Air) {
+				bits |= std::uint32_t{1} << (x + i);
+			}
+		}
+
+		rowOccupancy[y] = (rowOccupancy[y] & ~spanBits(x, x + count)) | bits;
+		updateRow(y);
+
+		return true;
+	}
+
+	[[nodiscard]] bool isEmpty() const noexcept {
+		return occupiedRows == 0;
+	}
+
+	[[nodiscard]] bool isRowEmpty(std::size_t y) const noexcept {
+		return rowOccupancy[y] == 0;
+	}
+
+	[[nodiscard]] bool isUniform() const noexcept {
+		return voxels.empty();
+	}
+
+	// Gives a uniform chunk storage for every voxel, edits that differ from the uniform voxel do this first.
+	void expand() {
+		if (!isUniform()) {
+			return;
+		}
+
+		voxels.assign(VOLUME, uniformVoxel);
+
+		// The single quad of a solid chunk spans every band.
+		if (uniformVoxel != vkx::Voxel::Air) {
+			dirtyRows = ALL_ROWS;
+		}
+	}
+
+	// Drops the storage when every voxel is the same, returns true when the chunk is uniform afterwards.
+	bool compact() {
+		if (isUniform()) {
+			return true;
+		}
+
+		// The occupancy bits rule out most chunks without looking at their voxels.
+		const auto first = voxels.front();
+		if (first == vkx::Voxel::Air ? occupiedRows != 0 : !std::all_of(rowOccupancy.begin(), rowOccupancy.end(), [](std::uint32_t row) { return row == FULL_ROW; })) {
+			return false;
+		}
+
+		if (!std::all_of(voxels.begin(), voxels.end(), [first](vkx::Voxel voxel) { return voxel == first; })) {
+			return false;
+		}
+
+		uniformVoxel = first;
+		voxels = {};
+
+		// Uniform chunks mesh differently, every band is stale.
+		dirtyRows = ALL_ROWS;
+
+		return true;
+	}
+
+	// Rebuilds the occupancy bits from the voxels and marks every row dirty.
+	void updateOccupancy() {
+		occupiedRows = 0;
+		dirtyRows = ALL_ROWS;
+
+		if (isUniform()) {
+			rowOccupancy.fill(uniformVoxel != vkx::Voxel::Air ? FULL_ROW : 0);
+			occupiedRows = uniformVoxel != vkx::Voxel::Air ? ALL_ROWS : 0;
+			return;
+		}
+
+		for (std::size_t y = 0; y < Height; y++) {
+			std::uint32_t row = 0;
+			for (std::size_t x = 0; x < Width; x++) {
+				if (voxels[index(x, y)] != vkx::Voxel::Air) {
+					row |= std::uint32_t{1} << x;
+				}
+			}
+
+			rowOccupancy[y] = row;
+			if (row != 0) {
+				occupiedRows |= std::uint32_t{1} << y;
+			}
+		}
+	}
+
+private:
+	// Occupancy bits of voxels minX up to maxX of a row.
+	[[nodiscard]] static constexpr std::uint32_t spanBits(std::size_t minX, std::size_t maxX) noexcept {
+		const auto width = maxX - minX;
+		return (width >= 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << width) - 1) << minX;
+	}
+
+	// Row y's occupancy bits changed.
+	void updateRow(std::size_t y) noexcept {
+		const auto rowBit = std::uint32_t{1} << y;
+		occupiedRows = rowOccupancy[y] != 0 ? occupiedRows | rowBit : occupiedRows & ~rowBit;
+		dirtyRows |= rowBit;
+	}
 };
-} // namespace vkx
\ No newline at end of file
+
+using VoxelChunk2D = BasicVoxelChunk2D<CHUNK_SIZE, CHUNK_SIZE>;
+} // namespace vkx
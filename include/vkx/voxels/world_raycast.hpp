@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vkx/raycast.hpp>
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+namespace vkx {
+// Walks voxels across chunk boundaries in global voxel coordinates. lookup(chunkCoordinate) returns the chunk or nullptr
+// when it is not loaded, predicate(voxel, position) decides what counts as a hit. Air never hits, so unloaded and empty
+// chunks and all-air rows are crossed in a single step using the occupancy bits. Like raycast2D the origin voxel is never hit.
+template <class Lookup, class Predicate>
+Raycast2DResult raycastWorld(const glm::vec2& origin, const glm::vec2& direction, float maxLength, Lookup lookup, Predicate predicate) {
+	constexpr auto chunkSize = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+	const auto step = derriveStep(direction);
+	const auto delta = derriveDelta(step, direction);
+	auto cross = derriveCross(step, origin, delta);
+
+	glm::ivec2 cell = glm::floor(origin);
+	glm::ivec2 previousCell = cell;
+	float length = 0.0f;
+
+	// Moves to the first voxel past the box, where the ray leaves it.
+	const auto leave = [&](const glm::ivec2& boxMin, const glm::ivec2& boxMax) {
+		glm::vec2 exit{std::numeric_limits<float>::infinity()};
+		for (glm::length_t axis = 0; axis < 2; axis++) {
+			if (step[axis] > 0) {
+				exit[axis] = (static_cast<float>(boxMax[axis]) - origin[axis]) * delta[axis];
+			} else if (step[axis] < 0) {
+				exit[axis] = (origin[axis] - static_cast<float>(boxMin[axis])) * delta[axis];
+			}
+		}
+
+		const glm::length_t axis = exit.x <= exit.y ? 0 : 1;
+		length = exit[axis];
+
+		cell = glm::clamp(glm::ivec2{glm::floor(origin + direction * length)}, boxMin, boxMax - 1);
+		cell[axis] = step[axis] > 0 ? boxMax[axis] : boxMin[axis] - 1;
+		previousCell = cell;
+		previousCell[axis] -= step[axis];
+
+		for (glm::length_t i = 0; i < 2; i++) {
+			if (step[i] > 0) {
+				cross[i] = (static_cast<float>(cell[i] + 1) - origin[i]) * delta[i];
+			} else if (step[i] < 0) {
+				cross[i] = (origin[i] - static_cast<float>(cell[i])) * delta[i];
+			}
+		}
+	};
+
+	auto isOrigin = true;
+	while (length <= maxLength) {
+		const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+		const auto chunkMin = chunkPosition * chunkSize;
+		const auto local = cell - chunkMin;
+		const vkx::VoxelChunk2D* chunk = lookup(chunkPosition);
+
+		if (!chunk || chunk->isEmpty()) {
+			leave(chunkMin, chunkMin + chunkSize);
+		} else if (chunk->isRowEmpty(static_cast<std::size_t>(local.y))) {
+			leave(glm::ivec2{chunkMin.x, cell.y}, glm::ivec2{chunkMin.x + chunkSize, cell.y + 1});
+		} else {
+			const auto voxel = chunk->at(static_cast<std::size_t>(local.x), static_cast<std::size_t>(local.y));
+			if (!isOrigin && voxel != vkx::Voxel::Air && predicate(voxel, cell)) {
+				return {true, length, glm::vec2{cell}, glm::vec2{previousCell}};
+			}
+
+			previousCell = cell;
+
+			if (cross.x < cross.y) {
+				cell.x += step.x;
+
+				length = cross.x;
+
+				cross.x += delta.x;
+			} else {
+				cell.y += step.y;
+
+				length = cross.y;
+
+				cross.y += delta.y;
+			}
+		}
+
+		isOrigin = false;
+	}
+
+	return {false, length, glm::vec2{0}, glm::vec2{0}};
+}
+} // namespace vkx
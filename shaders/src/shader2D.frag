@@ -1,11 +1,19 @@
 #version 450
 
+// 0 = textured, 1 = UV debug view
+layout (constant_id = 1) const int RENDER_MODE = 0;
+
 layout (location = 0) out vec4 outColor;
 
-layout (binding = 1) uniform sampler2D materialDiffuse;
+// One layer per voxel material.
+layout (binding = 1) uniform sampler2DArray materialDiffuse;
 
-layout (location = 0) in vec2 fragUV;
+layout (location = 0) in vec3 fragUV;
 
 void main() {
-    outColor = texture(materialDiffuse, fragUV);
-}
\ No newline at end of file
+    if (RENDER_MODE == 1) {
+        outColor = vec4(fract(fragUV.xy), 0.0, 1.0);
+    } else {
+        outColor = texture(materialDiffuse, fragUV);
+    }
+}
@@ -1,5 +1,7 @@
 #version 450
 
+layout (constant_id = 0) const float VOXEL_SCALE = 16.0;
+
 layout (binding = 0) uniform UniformBufferObject {
 	mat4 model;
 	mat4 view;
@@ -7,11 +9,11 @@ layout (binding = 0) uniform UniformBufferObject {
 } ubo;
 
 layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec2 aUV;
+layout (location = 1) in vec3 aUV;
 
-layout (location = 0) out vec2 fragUV;
+layout (location = 0) out vec3 fragUV;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(aPos, 1.0, 1.0);
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(aPos * VOXEL_SCALE, 1.0, 1.0);
 	fragUV = aUV;
 }
\ No newline at end of file
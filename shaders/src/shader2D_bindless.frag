@@ -0,0 +1,35 @@
+#version 450
+// Needed to index the runtime sized arrays below, every index is uniform across a draw so none is marked nonuniformEXT.
+#extension GL_EXT_nonuniform_qualifier : require
+
+// 0 = textured, 1 = UV debug view
+layout (constant_id = 1) const int RENDER_MODE = 0;
+
+layout (location = 0) out vec4 outColor;
+
+layout (location = 0) in vec3 fragUV;
+
+struct ObjectData {
+    uint textureIndex;
+};
+
+// Every texture and per object buffer lives in one table bound once per frame.
+layout (set = 1, binding = 0) uniform sampler2DArray textures[];
+
+layout (set = 1, binding = 1) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffers[];
+
+layout (push_constant) uniform DrawIndices {
+    uint objectBuffer;
+    uint object;
+} draw;
+
+void main() {
+    if (RENDER_MODE == 1) {
+        outColor = vec4(fract(fragUV.xy), 0.0, 1.0);
+    } else {
+        const uint textureIndex = objectBuffers[draw.objectBuffer].objects[draw.object].textureIndex;
+        outColor = texture(textures[textureIndex], fragUV);
+    }
+}
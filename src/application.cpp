@@ -1,26 +1,85 @@
 #include <vkx/application.hpp>
+#include <vkx/profiler.hpp>
+#include <vkx/physics/voxel_collision.hpp>
+#include <vkx/voxels/world_raycast.hpp>
 
 namespace vkx {
-application::application() {
+static constexpr std::uint32_t DRAW_COMMAND_AMOUNT = 1;
+
+// A simulation further behind than this many ticks drops the remaining time instead of trying to catch up.
+static constexpr std::uint32_t MAX_TICKS_PER_UPDATE = 8;
+
+// The camera collides as a box of this many voxels centered on its position.
+static constexpr glm::vec2 CAMERA_SIZE{0.8f, 0.8f};
+
+// Chunk jobs per tick of lockstep runs, which must not depend on how fast the machine runs them.
+static constexpr std::size_t LOCKSTEP_CHUNK_JOBS = 12;
+
+// Radius in voxels of the circle a blast clears.
+static constexpr std::int32_t BLAST_RADIUS = 6;
+
+// Ordered by vkx::materialLayer, stone and dirt share the only texture shipped so far.
+static const std::vector<std::string> MATERIAL_TEXTURES{"resources/a.jpg", "resources/a.jpg"};
+
+static std::string defaultAssetPackFile() {
+	char* basePath = SDL_GetBasePath();
+	if (!basePath) {
+		return "vkx.pack";
+	}
+
+	std::string file{basePath};
+	SDL_free(basePath);
+
+	return file + "vkx.pack";
+}
+
+application::application()
+    : application(vkx::ApplicationSettings{}) {}
+
+application::application(const vkx::ApplicationSettings& settings)
+    : settings(settings), chunkWindow(static_cast<std::int32_t>(settings.chunkRadius), glm::ivec2{0, 0}), chunkScheduler(chunkWindow.size()) {
 #ifdef DEBUG
 	SDL_Log("Hello!");
 #endif
 
-	if (SDL_Init(SDL_INIT_EVERYTHING & ~SDL_INIT_HAPTIC) != 0) {
+	const auto sdlFlags = settings.headless ? 0 : SDL_INIT_EVERYTHING & ~SDL_INIT_HAPTIC;
+	if (SDL_Init(sdlFlags) != 0) {
 		throw std::runtime_error(SDL_GetError());
 	}
 
-	window = SDL_CreateWindow("VKX", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 640, 480, SDL_WINDOW_HIDDEN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_VULKAN);
+	if (settings.headless) {
+		instance = vkx::VulkanInstance{vk::Extent2D{settings.width, settings.height}};
+	} else {
+		window = SDL_CreateWindow("VKX", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, static_cast<int>(settings.width), static_cast<int>(settings.height), SDL_WINDOW_HIDDEN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_VULKAN);
 
-	if (window == nullptr) {
-		throw std::runtime_error(SDL_GetError());
-	}
+		if (window == nullptr) {
+			throw std::runtime_error(SDL_GetError());
+		}
 
-	instance = vkx::VulkanInstance{window};
+		instance = vkx::VulkanInstance{window};
+	}
 
 	commandSubmitter = instance.createCommandSubmitter();
 
-	texture = vkx::Texture{"resources/a.jpg", instance, commandSubmitter};
+	gpuProfiler = instance.createGPUProfiler();
+	commandSubmitter.setProfiler(&gpuProfiler);
+
+	assets = vkx::AssetPack{settings.assetPackFile.empty() ? defaultAssetPackFile() : settings.assetPackFile};
+	if (!assets.isOpen() && !settings.assetPackFile.empty()) {
+		throw std::runtime_error("Failed to open asset pack " + settings.assetPackFile + ".");
+	}
+
+	auto uploadBatch = commandSubmitter.createUploadBatch();
+
+	const auto* materials = assets.find("materials");
+	if (materials) {
+		texture = vkx::Texture{*materials, instance, uploadBatch};
+	} else {
+		texture = vkx::Texture{MATERIAL_TEXTURES, instance, uploadBatch};
+	}
+
+	// Terrain is generated while the GPU works through the uploads.
+	uploadBatch.submit();
 
 	constexpr vk::DescriptorSetLayoutBinding uboLayoutBinding{
 	    0,
@@ -34,24 +93,99 @@ application::application() {
 	    1,
 	    vk::ShaderStageFlagBits::eFragment};
 
+	const auto useBindless = settings.bindless && instance.supportsBindless();
+	if (settings.bindless && !useBindless) {
+		SDL_Log("Descriptor indexing is unavailable, textures are bound per pipeline");
+	}
+
+	if (useBindless) {
+		bindless = instance.createBindlessTable();
+
+		// Every chunk samples the material array for now, the table leaves room for more.
+		const std::vector<std::uint32_t> objects(chunkWindow.size(), bindless.addTexture(texture));
+		objectBuffer = instance.allocateBuffer(objects.size() * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eStorageBuffer);
+		objectBuffer.mapMemory(objects.data(), objects.size() * sizeof(std::uint32_t));
+		objectBufferIndex = bindless.addBuffer(objectBuffer);
+	}
+
+	const auto* fragmentFile = assets.isOpen() ? (useBindless ? "shader2D_bindless.frag" : "shader2D.frag") : (useBindless ? "build/shader2D_bindless.frag.spv" : "build/shader2D.frag.spv");
+
+	const auto constants = vkx::pipeline::SpecializationConstants{}
+				   .set(vkx::pipeline::VOXEL_SCALE_CONSTANT_ID, vkx::VOXEL_SCALE)
+				   .set(vkx::pipeline::RENDER_MODE_CONSTANT_ID, vkx::pipeline::RenderMode::Textured);
+
 	const vkx::pipeline::GraphicsPipelineInformation graphicsPipelineInformation{
-	    "build/shader2D.vert.spv",
-	    "build/shader2D.frag.spv",
-	    {uboLayoutBinding, samplerLayoutBinding},
+	    assets.isOpen() ? "shader2D.vert" : "build/shader2D.vert.spv",
+	    fragmentFile,
+	    useBindless ? std::vector<vk::DescriptorSetLayoutBinding>{uboLayoutBinding} : std::vector<vk::DescriptorSetLayoutBinding>{uboLayoutBinding, samplerLayoutBinding},
 	    vkx::Vertex::getBindingDescription(),
 	    vkx::Vertex::getAttributeDescriptions(),
 	    {sizeof(vkx::MVP)},
-	    {&texture}};
+	    useBindless ? std::vector<const vkx::Texture*>{} : std::vector<const vkx::Texture*>{&texture},
+	    constants,
+	    assets.isOpen() ? &assets : nullptr,
+	    useBindless ? &bindless : nullptr};
 
 	pipeline = instance.createGraphicsPipeline(graphicsPipelineInformation);
 
+	drawCommands = commandSubmitter.allocateDrawCommands(DRAW_COMMAND_AMOUNT);
+	secondaryDrawCommands = commandSubmitter.allocateDrawCommands(static_cast<std::uint32_t>(chunkWindow.size()), vk::CommandBufferLevel::eSecondary);
+
+	syncObjects = instance.createSyncObjects();
+
+	chunks.reserve(chunkWindow.size());
+	meshes.reserve(chunkWindow.size());
+
+	for (std::size_t i = 0; i < chunkWindow.size(); i++) {
+		auto& currentChunk = chunks.emplace_back(glm::vec2{chunkWindow.coordinate(i)});
+		currentChunk.generateTerrain();
+		// Device buffers are allocated once the mesh is in view and has anything to draw.
+		auto& currentMesh = meshes.emplace_back();
+		currentMesh.vertices.resize(vkx::VoxelChunk2D::MAX_VERTICES);
+		currentMesh.indices.resize(vkx::VoxelChunk2D::MAX_INDICES);
+		currentChunk.generateMesh(currentMesh);
+	}
+
+	residency = vkx::ResidencyManager{instance, meshes.size(), settings.memoryCeiling};
+
+	uploadBatch.wait();
+	uploadBatch.destroy();
+
+	const auto extent = instance.getSwapchain().imageExtent;
+	projection = glm::ortho(0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 0.1f, 100.0f);
+
+	if (!instance.hasMemoryBudget()) {
+		SDL_Log("VK_EXT_memory_budget is unavailable, memory budgets are estimated");
+	}
+
+	if (!settings.recordFile.empty()) {
+		recorder = vkx::InputRecorder{settings.recordFile};
+	}
+
+	if (!settings.replayFile.empty()) {
+		replayer = vkx::InputReplayer{settings.replayFile};
+	}
 }
 
 application::~application() {
+	stopSimulation();
+
 	instance.waitIdle();
 
+	residency.destroy();
+	for (auto& mesh : meshes) {
+		mesh.destroy();
+	}
+
+	syncObjects.clear();
+	if (bindless.getSet()) {
+		objectBuffer.destroy();
+		bindless.destroy();
+	}
 	texture.destroy();
+	assets.destroy();
 	pipeline.destroy();
+	gpuProfiler.destroy();
 	commandSubmitter.destroy();
 	instance.destroy();
 
@@ -70,36 +204,575 @@ void application::run() {
 	isRunning = true;
 
 	std::uint32_t currentFrame = 0;
-	bool framebufferResized = false;
+	std::uint32_t frameCount = 0;
 
-	SDL_ShowWindow(window);
+	if (window) {
+		SDL_ShowWindow(window);
+	}
+
+	lockstep = replayer.isOpen() || instance.isHeadless();
+
+	// The render thread always has a snapshot to draw.
+	publishInput();
+	tick();
+
+	const auto start = std::chrono::steady_clock::now();
 	while (isRunning) {
+		VKX_PROFILE_ZONE("frame");
+
+		const auto frameStart = std::chrono::steady_clock::now();
+
 		poll();
+
+		publishInput();
+
+		if (lockstep) {
+			for (std::uint32_t i = 0; i < lockstepTicks; i++) {
+				tick();
+			}
+		} else if (!simulationThread.joinable()) {
+			// Started once the first frame's input is published, so every tick it runs is on recorded input.
+			simulating = true;
+			simulationThread = std::thread{&application::simulate, this};
+		} else if (!simulating.load(std::memory_order_acquire)) {
+			break;
+		}
+
+		if (render(currentFrame)) {
+			currentFrame = (currentFrame + 1) % vkx::MAX_FRAMES_IN_FLIGHT;
+			frameCount++;
+			collectStatistics(frameCount, frameStart);
+		}
+
+		if (settings.frameLimit != 0 && frameCount >= settings.frameLimit) {
+			isRunning = false;
+		}
 	}
 
-	// cleanup?
+	stopSimulation();
+	recorder.finish(ticksOnInput);
+
+	instance.waitIdle();
+
+	if (simulationError) {
+		std::rethrow_exception(simulationError);
+	}
+
+	if (!settings.traceFile.empty() && !vkx::profiler::writeChromeTrace(settings.traceFile)) {
+		SDL_Log("Failed to write trace to %s", settings.traceFile.c_str());
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	SDL_Log("Rendered %u frames in %.3f seconds (%.1f fps)", frameCount, elapsed.count(), static_cast<double>(frameCount) / elapsed.count());
+
+	for (const auto& label : gpuProfiler.getLabels()) {
+		const auto timings = gpuProfiler.timings(label);
+		SDL_Log("GPU %s: min %.3f ms, avg %.3f ms, max %.3f ms over %zu samples", label.c_str(), timings.minimum, timings.average, timings.maximum, timings.samples);
+	}
+
+	const auto budgets = instance.getMemoryBudgets();
+	for (std::size_t i = 0; i < budgets.size(); i++) {
+		const auto& budget = budgets[i];
+		SDL_Log("Heap %zu%s: %.1f MiB used of %.1f MiB budget", i, budget.deviceLocal ? " (device local)" : "", static_cast<double>(budget.usage) / 1048576.0, static_cast<double>(budget.budget) / 1048576.0);
+	}
+	SDL_Log("%zu of %zu chunk meshes resident", residency.residentCount(meshes), meshes.size());
+
+	reportStatistics();
+}
+
+void application::simulate() {
+	const std::chrono::duration<double> tickDuration{1.0 / settings.tickRate};
+	std::chrono::duration<double> accumulator{0};
+
+	try {
+		auto previousTime = std::chrono::steady_clock::now();
+		while (simulating.load(std::memory_order_acquire)) {
+			const auto now = std::chrono::steady_clock::now();
+			accumulator += std::min<std::chrono::duration<double>>(now - previousTime, tickDuration * MAX_TICKS_PER_UPDATE);
+			previousTime = now;
+
+			while (accumulator >= tickDuration) {
+				tick();
+				accumulator -= tickDuration;
+			}
+
+			std::this_thread::sleep_for(tickDuration - accumulator);
+		}
+	} catch (...) {
+		simulationError = std::current_exception();
+		simulating.store(false, std::memory_order_release);
+	}
+}
+
+void application::stopSimulation() {
+	simulating.store(false, std::memory_order_release);
+
+	if (simulationThread.joinable()) {
+		simulationThread.join();
+	}
+}
+
+bool application::hasRegressed() const noexcept {
+	return regressed;
+}
+
+void application::collectStatistics(std::uint32_t frameCount, std::chrono::steady_clock::time_point frameStart) {
+	const std::chrono::duration<float, std::milli> cpuTime = std::chrono::steady_clock::now() - frameStart;
+	frameSample.cpuMilliseconds = cpuTime.count();
+
+	// Queries resolve a few frames late, so this is the latest render pass that finished rather than this frame's.
+	const auto gpuTimings = gpuProfiler.timings("render pass");
+	if (gpuTimings.resolved != gpuSamplesResolved) {
+		gpuSamplesResolved = gpuTimings.resolved;
+		frameSample.gpuMilliseconds = gpuTimings.latest;
+	}
+
+	if (frameCount > settings.warmupFrames) {
+		statistics.add(frameSample);
+	}
+
+	frameSample.chunksGenerated = 0;
+	frameSample.bytesUploaded = 0;
+}
+
+void application::reportStatistics() {
+	if (settings.statisticsFile.empty() && settings.baselineFile.empty()) {
+		return;
+	}
+
+	if (statistics.size() == 0) {
+		SDL_Log("No frames past the %u warmup frames were measured", settings.warmupFrames);
+		return;
+	}
+
+	const auto summary = statistics.summarize();
+	SDL_Log("CPU frame time: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms", summary.cpuMilliseconds.p50, summary.cpuMilliseconds.p95, summary.cpuMilliseconds.p99);
+	SDL_Log("GPU frame time: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms", summary.gpuMilliseconds.p50, summary.gpuMilliseconds.p95, summary.gpuMilliseconds.p99);
+
+	if (!settings.statisticsFile.empty() && !vkx::writeSummary(settings.statisticsFile, summary)) {
+		SDL_Log("Failed to write frame statistics to %s", settings.statisticsFile.c_str());
+	}
+
+	if (settings.baselineFile.empty()) {
+		return;
+	}
+
+	const auto regressions = vkx::findRegressions(vkx::readSummary(settings.baselineFile), summary, settings.regressionThreshold);
+	for (const auto& regression : regressions) {
+		SDL_Log("Regression: %s", regression.c_str());
+	}
+
+	regressed = !regressions.empty();
 }
 
 void application::poll() {
+	VKX_PROFILE_ZONE("poll");
+
+	if (replayer.isOpen()) {
+		replay();
+		return;
+	}
+
+	if (!window) {
+		return;
+	}
+
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
-		const auto eventType = event.type;
+		recorder.record(event);
+		handleEvent(event);
+	}
 
-		switch (eventType) {
-		case SDL_QUIT:
-			isRunning = false;
-			break;
-		case SDL_WINDOWEVENT:
-			break;
-		case SDL_KEYDOWN:
-			break;
-		case SDL_KEYUP:
-			break;
-		case SDL_MOUSEMOTION:
-			break;
-		default:
-			break;
+	recorder.endFrame(snapshots.read().cameraPosition, direction);
+}
+
+void application::publishInput() {
+	input.direction = direction;
+	input.extent = instance.getSwapchain().imageExtent;
+
+	inputs.write() = input;
+
+	std::uint32_t previousTicks = 0;
+	{
+		const std::lock_guard<std::mutex> lock{inputMutex};
+		inputs.publish();
+		previousTicks = std::exchange(ticksOnInput, 0);
+	}
+	recorder.publishFrame(previousTicks);
+
+	input.hasPosition = false;
+}
+
+void application::replay() {
+	// Window events still need handling, recorded input replaces everything else.
+	SDL_Event event;
+	while (window && SDL_PollEvent(&event)) {
+		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT) {
+			handleEvent(event);
+		}
+	}
+
+	const auto* frame = replayer.next();
+	if (!frame) {
+		isRunning = false;
+		lockstepTicks = 0;
+		return;
+	}
+
+	for (const auto& inputEvent : frame->events) {
+		handleEvent(inputEvent.toSDLEvent());
+	}
+
+	// The recorded state is authoritative, so a replay walks the exact same path through the world.
+	input.hasPosition = true;
+	input.position = frame->cameraPosition;
+	direction = frame->direction;
+	lockstepTicks = frame->ticks;
+}
+
+void application::handleEvent(const SDL_Event& event) {
+	switch (event.type) {
+	case SDL_QUIT:
+		isRunning = false;
+		break;
+	case SDL_WINDOWEVENT:
+		if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
+			framebufferResized = true;
+		}
+		break;
+	case SDL_KEYDOWN:
+		keyPressed(event.key);
+		break;
+	case SDL_KEYUP:
+		keyReleased(event.key);
+		break;
+	case SDL_MOUSEMOTION:
+		mouseMoved(event.motion);
+		break;
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+		mouseButton(event.button);
+		break;
+	default:
+		break;
+	}
+}
+
+void application::tick() {
+	VKX_PROFILE_ZONE("tick");
+
+	bool freshInput = false;
+	{
+		const std::lock_guard<std::mutex> lock{inputMutex};
+		freshInput = inputs.acquire();
+		ticksOnInput++;
+	}
+	const auto& tickInput = inputs.read();
+
+	if (freshInput && tickInput.hasPosition) {
+		cameraPosition = tickInput.position;
+	}
+
+	previousCameraPosition = cameraPosition;
+
+	// Slides along solid voxels instead of passing through them.
+	const auto lookup = [this](const glm::ivec2& chunk) { return readyChunk(chunk); };
+	const auto swept = vkx::sweepBox(cameraPosition - CAMERA_SIZE * 0.5f, CAMERA_SIZE, tickInput.direction, lookup);
+	cameraPosition = swept.position + CAMERA_SIZE * 0.5f;
+
+	chunkWindow.move(cameraPosition, cameraPosition - previousCameraPosition, changedChunks);
+
+	for (const auto i : changedChunks) {
+		chunks[i].globalPosition = glm::vec2{chunkWindow.coordinate(i)} * static_cast<float>(vkx::CHUNK_SIZE);
+		chunkScheduler.schedule(i);
+	}
+
+	// The view is centered on the camera and measured in voxels here.
+	const glm::vec2 halfView{static_cast<float>(tickInput.extent.width) / (2.0f * vkx::VOXEL_SCALE), static_cast<float>(tickInput.extent.height) / (2.0f * vkx::VOXEL_SCALE)};
+	const auto viewMin = cameraPosition - halfView;
+	const auto viewMax = cameraPosition + halfView;
+
+	visibleChunks.clear();
+	for (std::size_t i = 0; i < chunks.size(); i++) {
+		const auto chunkMin = chunks[i].globalPosition;
+		const auto chunkMax = chunkMin + static_cast<float>(vkx::CHUNK_SIZE);
+
+		if (chunkMax.x >= viewMin.x && chunkMin.x <= viewMax.x && chunkMax.y >= viewMin.y && chunkMin.y <= viewMax.y) {
+			residency.markVisible(i);
+			visibleChunks.push_back(i);
+		}
+	}
+
+	const std::chrono::duration<double, std::milli> chunkBudget{settings.chunkBudgetMilliseconds};
+	const auto work = chunkScheduler.run(chunks, meshes, residency, visibleChunks, cameraPosition, chunkBudget, lockstep ? LOCKSTEP_CHUNK_JOBS : 0);
+	chunksGenerated += work.chunksGenerated;
+	bytesUploaded += work.bytesUploaded;
+
+	// Meshes evicted by this update are left out of this tick's snapshot, so its tick is the frame the update runs as.
+	const auto frame = residency.currentFrame();
+	bytesUploaded += residency.update(meshes, oldestTickInUse.load(std::memory_order_acquire));
+
+	if (tickInput.mousePosition != highlightMousePosition) {
+		updateHighlight(tickInput);
+	}
+
+	if (hasHighlight && tickInput.breaking) {
+		edits.push(highlightVoxel, vkx::Voxel::Air);
+	}
+
+	// Stone is never placed inside the camera, which could not sweep out of it.
+	const auto cameraMin = cameraPosition - CAMERA_SIZE * 0.5f;
+	const auto cameraMax = cameraPosition + CAMERA_SIZE * 0.5f;
+	const glm::vec2 front{highlightFront};
+	const auto insideCamera = front.x < cameraMax.x && front.x + 1.0f > cameraMin.x && front.y < cameraMax.y && front.y + 1.0f > cameraMin.y;
+	if (hasHighlight && tickInput.placing && !insideCamera) {
+		edits.push(highlightFront, vkx::Voxel::Stone);
+	}
+
+	// Every edit since the last tick lands before any remesh, so each edited chunk is remeshed once.
+	edits.apply(chunkWindow, chunks, chunkScheduler, editedChunks);
+
+	if (hasHighlight && tickInput.blasting) {
+		vkx::RegionEditor editor{chunkWindow, chunks, chunkScheduler, editedChunks};
+		editor.fillCircle(highlightVoxel, BLAST_RADIUS, vkx::Voxel::Air);
+	}
+
+	for (const auto slot : editedChunks) {
+		chunks[slot].remesh(meshes[slot]);
+		// Only the remeshed bands are written, into buffers no frame in flight draws.
+		bytesUploaded += residency.reupload(meshes[slot]);
+	}
+
+	if (!editedChunks.empty()) {
+		updateHighlight(tickInput);
+	}
+
+	auto& snapshot = snapshots.write();
+	snapshot.tick = frame;
+	snapshot.time = std::chrono::steady_clock::now();
+	snapshot.previousCameraPosition = previousCameraPosition;
+	snapshot.cameraPosition = cameraPosition;
+	snapshot.highlightMatrix = highlightMatrix;
+	snapshot.chunksGenerated = chunksGenerated;
+	snapshot.bytesUploaded = bytesUploaded;
+
+	snapshot.meshes.clear();
+	for (const auto i : visibleChunks) {
+		const auto& mesh = meshes[i];
+		if (mesh.isResident() && chunkScheduler.isReady(i)) {
+			snapshot.meshes.push_back({static_cast<vk::Buffer>(mesh.vertexBuffer), static_cast<vk::Buffer>(mesh.indexBuffer), static_cast<std::uint32_t>(mesh.activeIndexCount), static_cast<std::uint32_t>(i)});
+		}
+	}
+
+	snapshots.publish();
+}
+
+bool application::render(std::uint32_t currentFrame) {
+	const auto& swapchain = instance.getSwapchain();
+	const glm::vec2 windowCenter{static_cast<float>(swapchain.imageExtent.width / 2), static_cast<float>(swapchain.imageExtent.height / 2)};
+
+	snapshots.acquire();
+	const auto& snapshot = snapshots.read();
+
+	frameSample.chunksGenerated += snapshot.chunksGenerated - reportedChunks;
+	frameSample.bytesUploaded += snapshot.bytesUploaded - reportedBytes;
+	reportedChunks = snapshot.chunksGenerated;
+	reportedBytes = snapshot.bytesUploaded;
+
+	// Frames are drawn between the last two ticks, lockstep frames draw the tick that just ran.
+	const std::chrono::duration<double> tickDuration{1.0 / settings.tickRate};
+	const auto alpha = lockstep ? 1.0f : glm::clamp(static_cast<float>((std::chrono::steady_clock::now() - snapshot.time) / tickDuration), 0.0f, 1.0f);
+	camera.globalPosition = glm::mix(snapshot.previousCameraPosition, snapshot.cameraPosition, alpha);
+
+	const auto& mvpBuffer = pipeline.getUniformByIndex(0)[currentFrame];
+	const vkx::MVP mvp{glm::mat4(glm::translate(glm::mat3(1.0f), windowCenter)), camera.viewMatrix(), projection};
+
+	const auto& syncObject = syncObjects[currentFrame];
+	syncObject.waitForFence();
+
+	// This frame's previous snapshot is no longer drawn, buffers evicted since the oldest one still drawn can go.
+	frameTicks[currentFrame] = snapshot.tick;
+	oldestTickInUse.store(*std::min_element(frameTicks.begin(), frameTicks.end()), std::memory_order_release);
+
+	mvpBuffer.mapMemory(mvp);
+
+	// Offscreen targets are owned per frame in flight, the fence above already guarantees this one is idle.
+	std::uint32_t imageIndex = currentFrame;
+	if (!instance.isHeadless()) {
+		const auto [result, acquiredIndex] = instance.acquireNextImage(syncObject);
+
+		if (result == vk::Result::eErrorOutOfDateKHR) {
+			recreateSwapchain();
+			return false;
+		} else if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
+			throw std::runtime_error("Failed to acquire next image.");
 		}
+
+		imageIndex = acquiredIndex;
+	}
+
+	syncObject.resetFence();
+
+	const vkx::DrawInfo chunkDrawInfo{
+	    imageIndex,
+	    currentFrame,
+	    &swapchain,
+	    &pipeline,
+	    snapshot.meshes,
+	    &gpuProfiler,
+	    objectBufferIndex};
+
+	const auto* begin = &drawCommands[currentFrame * DRAW_COMMAND_AMOUNT];
+	const auto* secondaryBegin = &secondaryDrawCommands[currentFrame * chunkWindow.size()];
+
+	{
+		VKX_PROFILE_ZONE("record commands");
+		commandSubmitter.recordSecondaryDrawCommands(instance, begin, DRAW_COMMAND_AMOUNT, secondaryBegin, static_cast<std::uint32_t>(snapshot.meshes.size()), chunkDrawInfo);
+	}
+
+	if (instance.isHeadless()) {
+		VKX_PROFILE_ZONE("submit");
+		commandSubmitter.submitOffscreenDrawCommands(begin, DRAW_COMMAND_AMOUNT, syncObject);
+		return true;
+	}
+
+	{
+		VKX_PROFILE_ZONE("submit");
+		commandSubmitter.submitDrawCommands(begin, DRAW_COMMAND_AMOUNT, syncObject);
+	}
+
+	vk::Result result{};
+	{
+		VKX_PROFILE_ZONE("present");
+		result = commandSubmitter.presentToSwapchain(swapchain, imageIndex, syncObject);
+	}
+
+	if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR || framebufferResized) {
+		framebufferResized = false;
+		recreateSwapchain();
+	} else if (result != vk::Result::eSuccess) {
+		throw std::runtime_error("Failed to present.");
+	}
+
+	return true;
+}
+
+void application::recreateSwapchain() {
+	int windowWidth = 0;
+	int windowHeight = 0;
+	SDL_GetWindowSizeInPixels(window, &windowWidth, &windowHeight);
+	while (windowWidth == 0 || windowHeight == 0) {
+		SDL_GetWindowSizeInPixels(window, &windowWidth, &windowHeight);
+		SDL_WaitEvent(nullptr);
+	}
+
+	instance.recreateSwapchain();
+
+	const auto extent = instance.getSwapchain().imageExtent;
+	projection = glm::ortho(0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 0.1f, 100.0f);
+}
+
+void application::keyPressed(const SDL_KeyboardEvent& key) {
+	if (key.keysym.sym == SDLK_ESCAPE) {
+		isRunning = false;
+	}
+
+	if (key.keysym.sym == SDLK_F12) {
+		const auto file = settings.traceFile.empty() ? std::string{"vkx_trace.json"} : settings.traceFile;
+		if (!vkx::profiler::writeChromeTrace(file)) {
+			SDL_Log("Failed to write trace to %s", file.c_str());
+		}
+	}
+
+	const auto left = key.keysym.sym == SDLK_a;
+	const auto right = key.keysym.sym == SDLK_d;
+
+	const auto up = key.keysym.sym == SDLK_w;
+	const auto down = key.keysym.sym == SDLK_s;
+
+	const auto xDirection = right - left;
+	const auto yDirection = up - down;
+
+	if (std::abs(xDirection)) {
+		direction.x = static_cast<float>(xDirection);
 	}
+
+	if (std::abs(yDirection)) {
+		direction.y = static_cast<float>(yDirection);
+	}
+}
+
+void application::keyReleased(const SDL_KeyboardEvent& key) {
+	const auto left = key.keysym.sym == SDLK_a;
+	const auto right = key.keysym.sym == SDLK_d;
+
+	const int up = key.keysym.sym == SDLK_w;
+	const int down = key.keysym.sym == SDLK_s;
+
+	const auto xDirection = right - left;
+	const auto yDirection = up - down;
+
+	if (std::abs(xDirection)) {
+		direction.x = 0.0f;
+	}
+
+	if (std::abs(yDirection)) {
+		direction.y = 0.0f;
+	}
+}
+
+void application::mouseMoved(const SDL_MouseMotionEvent& motion) {
+	// Chunks belong to the simulation, which raycasts on its next tick.
+	input.mousePosition = glm::vec2{motion.x, motion.y};
+}
+
+void application::mouseButton(const SDL_MouseButtonEvent& button) {
+	const auto pressed = button.state == SDL_PRESSED;
+
+	if (button.button == SDL_BUTTON_LEFT) {
+		input.breaking = pressed;
+	}
+
+	if (button.button == SDL_BUTTON_RIGHT) {
+		input.placing = pressed;
+	}
+
+	if (button.button == SDL_BUTTON_MIDDLE) {
+		input.blasting = pressed;
+	}
+}
+
+void application::updateHighlight(const vkx::InputState& state) {
+	highlightMousePosition = state.mousePosition;
+
+	// The window center shows the camera and a voxel spans VOXEL_SCALE pixels.
+	const glm::vec2 windowCenter{static_cast<float>(state.extent.width) / 2.0f, static_cast<float>(state.extent.height) / 2.0f};
+	const auto offset = (state.mousePosition - windowCenter) / vkx::VOXEL_SCALE;
+	const auto distance = glm::length(offset);
+	hasHighlight = false;
+	if (distance == 0.0f) {
+		return;
+	}
+
+	const auto lookup = [this](const glm::ivec2& chunk) { return readyChunk(chunk); };
+
+	// Picks the first solid voxel between the camera and the cursor.
+	const auto result = vkx::raycastWorld(cameraPosition, offset / distance, distance, lookup, [](vkx::Voxel, const glm::ivec2&) { return true; });
+	if (result.success) {
+		highlightMatrix = glm::mat4(glm::translate(glm::mat3(1.0f), result.hitPosition * vkx::VOXEL_SCALE));
+		hasHighlight = true;
+		highlightVoxel = glm::ivec2{glm::floor(result.hitPosition)};
+		highlightFront = glm::ivec2{glm::floor(result.previousHitPosition)};
+	}
+}
+
+const vkx::VoxelChunk2D* application::readyChunk(const glm::ivec2& chunk) const {
+	if (!chunkWindow.contains(chunk)) {
+		return nullptr;
+	}
+
+	// Chunks still waiting on the scheduler hold stale voxels.
+	const auto slot = chunkWindow.slot(chunk);
+	return chunkScheduler.isReady(slot) ? &chunks[slot] : nullptr;
 }
 }
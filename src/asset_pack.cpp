@@ -0,0 +1,226 @@
+#include <vkx/asset_pack.hpp>
+
+#include <stb/stb_image.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr std::array<char, 4> PACK_MAGIC{'V', 'K', 'X', 'P'};
+
+static constexpr std::uint32_t PACK_VERSION = UINT32_C(1);
+
+static constexpr std::size_t PACK_HEADER_SIZE = PACK_MAGIC.size() + 2 * sizeof(std::uint32_t);
+
+template <class T>
+static void writeValue(std::ofstream& file, const T& value) {
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static std::size_t alignOffset(std::size_t offset) {
+	return (offset + vkx::ASSET_ALIGNMENT - 1) & ~(vkx::ASSET_ALIGNMENT - 1);
+}
+
+static std::pair<const std::uint8_t*, std::size_t> mapFile(const std::string& file) {
+#ifdef _WIN32
+	const auto handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return {nullptr, 0};
+	}
+
+	LARGE_INTEGER fileSize{};
+	GetFileSizeEx(handle, &fileSize);
+
+	const auto mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(handle);
+	if (!mappingHandle) {
+		throw std::runtime_error("Failed to map asset pack " + file + ".");
+	}
+
+	const auto* data = static_cast<const std::uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	CloseHandle(mappingHandle);
+	if (!data) {
+		throw std::runtime_error("Failed to map asset pack " + file + ".");
+	}
+
+	return {data, static_cast<std::size_t>(fileSize.QuadPart)};
+#else
+	const auto descriptor = open(file.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		return {nullptr, 0};
+	}
+
+	struct stat status {};
+	if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+		close(descriptor);
+		throw std::runtime_error("Failed to map asset pack " + file + ".");
+	}
+
+	const auto size = static_cast<std::size_t>(status.st_size);
+	auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (data == MAP_FAILED) {
+		throw std::runtime_error("Failed to map asset pack " + file + ".");
+	}
+
+	return {static_cast<const std::uint8_t*>(data), size};
+#endif
+}
+
+static void unmapFile(const std::uint8_t* data, [[maybe_unused]] std::size_t size) {
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<std::uint8_t*>(data), size);
+#endif
+}
+
+vkx::AssetPack::AssetPack(const std::string& file) {
+	const auto [data, size] = mapFile(file);
+	if (!data) {
+		return;
+	}
+
+	mapping = data;
+	mappingSize = size;
+
+	std::uint32_t version = 0;
+	std::uint32_t count = 0;
+	if (size < PACK_HEADER_SIZE || !std::equal(PACK_MAGIC.begin(), PACK_MAGIC.end(), reinterpret_cast<const char*>(data))) {
+		destroy();
+		throw std::runtime_error(file + " is not an asset pack.");
+	}
+
+	std::memcpy(&version, data + PACK_MAGIC.size(), sizeof(version));
+	std::memcpy(&count, data + PACK_MAGIC.size() + sizeof(version), sizeof(count));
+	if (version != PACK_VERSION || count > (size - PACK_HEADER_SIZE) / sizeof(Entry)) {
+		destroy();
+		throw std::runtime_error("Unsupported or truncated asset pack " + file + ".");
+	}
+
+	assets.reserve(count);
+	for (std::uint32_t i = 0; i < count; i++) {
+		Entry entry{};
+		std::memcpy(&entry, data + PACK_HEADER_SIZE + i * sizeof(Entry), sizeof(Entry));
+
+		// Written so that malformed offsets and sizes cannot wrap around.
+		if (entry.offset > size || entry.size > size - entry.offset) {
+			destroy();
+			throw std::runtime_error("Asset pack " + file + " has an entry past its end.");
+		}
+
+		const std::string name{entry.name.data(), strnlen(entry.name.data(), entry.name.size())};
+		assets[name] = vkx::AssetView{entry.type, data + entry.offset, static_cast<std::size_t>(entry.size), entry.width, entry.height, entry.layers};
+	}
+}
+
+bool vkx::AssetPack::isOpen() const noexcept {
+	return mapping != nullptr;
+}
+
+const vkx::AssetView* vkx::AssetPack::find(const std::string& name) const {
+	const auto iter = assets.find(name);
+	if (iter == assets.end()) {
+		return nullptr;
+	}
+
+	return &iter->second;
+}
+
+void vkx::AssetPack::destroy() {
+	if (mapping) {
+		unmapFile(mapping, mappingSize);
+	}
+
+	mapping = nullptr;
+	mappingSize = 0;
+	assets.clear();
+}
+
+void vkx::AssetPackWriter::addShader(const std::string& name, const std::string& file) {
+	std::ifstream input{file, std::ios::binary};
+	if (!input.is_open()) {
+		throw std::runtime_error("Failed to open shader " + file + ".");
+	}
+
+	std::vector<std::uint8_t> data{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+	if (data.empty() || data.size() % sizeof(std::uint32_t) != 0) {
+		throw std::runtime_error(file + " is not SPIR-V.");
+	}
+
+	pending.push_back({name, vkx::AssetType::Shader, 0, 0, 0, std::move(data)});
+}
+
+void vkx::AssetPackWriter::addTexture(const std::string& name, const std::vector<std::string>& files) {
+	int width = 0;
+	int height = 0;
+	std::vector<std::uint8_t> data{};
+	for (const auto& file : files) {
+		int layerWidth;
+		int layerHeight;
+		int channels;
+		stbi_uc* pixels = stbi_load(file.c_str(), &layerWidth, &layerHeight, &channels, STBI_rgb_alpha);
+		if (!pixels) {
+			throw std::runtime_error("Failed to load texture image " + file + ".");
+		}
+
+		if (data.empty()) {
+			width = layerWidth;
+			height = layerHeight;
+		} else if (layerWidth != width || layerHeight != height) {
+			stbi_image_free(pixels);
+			throw std::runtime_error("Texture layers must share the same dimensions.");
+		}
+
+		data.insert(data.end(), pixels, pixels + static_cast<std::size_t>(width) * height * STBI_rgb_alpha);
+		stbi_image_free(pixels);
+	}
+
+	pending.push_back({name, vkx::AssetType::Texture, static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), static_cast<std::uint32_t>(files.size()), std::move(data)});
+}
+
+void vkx::AssetPackWriter::write(const std::string& file) const {
+	std::ofstream output{file, std::ios::binary | std::ios::trunc};
+	if (!output.is_open()) {
+		throw std::runtime_error("Failed to open asset pack " + file + " for writing.");
+	}
+
+	output.write(PACK_MAGIC.data(), PACK_MAGIC.size());
+	writeValue(output, PACK_VERSION);
+	writeValue(output, static_cast<std::uint32_t>(pending.size()));
+
+	auto offset = alignOffset(PACK_HEADER_SIZE + pending.size() * sizeof(AssetPack::Entry));
+	for (const auto& asset : pending) {
+		if (asset.name.size() >= vkx::ASSET_NAME_SIZE) {
+			throw std::runtime_error("Asset name " + asset.name + " is too long.");
+		}
+
+		AssetPack::Entry entry{};
+		std::copy(asset.name.begin(), asset.name.end(), entry.name.begin());
+		entry.type = asset.type;
+		entry.width = asset.width;
+		entry.height = asset.height;
+		entry.layers = asset.layers;
+		entry.offset = offset;
+		entry.size = asset.data.size();
+		writeValue(output, entry);
+
+		offset = alignOffset(offset + asset.data.size());
+	}
+
+	for (const auto& asset : pending) {
+		const auto position = static_cast<std::size_t>(output.tellp());
+		const std::vector<char> padding(alignOffset(position) - position, 0);
+		output.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+		output.write(reinterpret_cast<const char*>(asset.data.data()), static_cast<std::streamsize>(asset.data.size()));
+	}
+
+	if (!output.good()) {
+		throw std::runtime_error("Failed to write asset pack " + file + ".");
+	}
+}
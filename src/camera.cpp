@@ -1,4 +1,5 @@
 #include <vkx/camera.hpp>
+#include <vkx/voxels/voxels.hpp>
 
 vkx::Camera2D::Camera2D(const glm::vec2& globalPosition,
 			const glm::vec2& rotation,
@@ -7,7 +8,7 @@ vkx::Camera2D::Camera2D(const glm::vec2& globalPosition,
 
 glm::mat4 vkx::Camera2D::viewMatrix() const noexcept {
 	const auto viewRotation = glm::mat3_cast(glm::conjugate(yawOrientation * pitchOrientation));
-	const auto viewTranslation = glm::translate(glm::mat3(1), -globalPosition * 16.0f);
+	const auto viewTranslation = glm::translate(glm::mat3(1), -globalPosition * vkx::VOXEL_SCALE);
 	return viewRotation * viewTranslation;
 }
 
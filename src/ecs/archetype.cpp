@@ -0,0 +1,136 @@
+#include <vkx/ecs/archetype.hpp>
+
+static std::vector<vkx::ComponentInfo>& componentTable() {
+	static std::vector<vkx::ComponentInfo> table{};
+	return table;
+}
+
+static std::mutex componentMutex{};
+
+static std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+std::uint32_t vkx::registerComponent(std::size_t size, std::size_t alignment) {
+	std::lock_guard lock{componentMutex};
+
+	auto& table = componentTable();
+	if (table.size() == vkx::MAX_COMPONENTS) {
+		throw std::runtime_error("Too many component types.");
+	}
+
+	table.push_back(vkx::ComponentInfo{size, alignment});
+	return static_cast<std::uint32_t>(table.size() - 1);
+}
+
+const vkx::ComponentInfo& vkx::componentInfo(std::uint32_t id) {
+	std::lock_guard lock{componentMutex};
+	return componentTable().at(id);
+}
+
+vkx::Archetype::Archetype(vkx::ComponentMask mask)
+    : mask(mask) {
+	std::size_t rowBytes = 0;
+	for (std::uint32_t id = 0; id < vkx::MAX_COMPONENTS; id++) {
+		if (mask & (vkx::ComponentMask{1} << id)) {
+			components.push_back(id);
+			sizes[id] = componentInfo(id).size;
+			rowBytes += sizes[id];
+		}
+	}
+
+	// Arrays are laid out one after another, the alignment padding between them may cost a few rows.
+	capacity = rowBytes == 0 ? CHUNK_BYTES : std::max<std::size_t>(CHUNK_BYTES / rowBytes, 1);
+	while (true) {
+		std::size_t offset = 0;
+		for (const auto id : components) {
+			const auto& info = componentInfo(id);
+			offset = alignUp(offset, info.alignment);
+			offsets[id] = offset;
+			offset += info.size * capacity;
+		}
+
+		if (offset <= CHUNK_BYTES || capacity == 1) {
+			chunkBytes = offset;
+			break;
+		}
+
+		capacity--;
+	}
+}
+
+vkx::ComponentMask vkx::Archetype::getMask() const noexcept {
+	return mask;
+}
+
+const std::vector<std::uint32_t>& vkx::Archetype::getComponents() const noexcept {
+	return components;
+}
+
+std::size_t vkx::Archetype::size() const noexcept {
+	return count;
+}
+
+std::size_t vkx::Archetype::componentSize(std::uint32_t id) const noexcept {
+	return sizes[id];
+}
+
+std::size_t vkx::Archetype::getCapacity() const noexcept {
+	return capacity;
+}
+
+std::size_t vkx::Archetype::chunkCount() const noexcept {
+	return (count + capacity - 1) / capacity;
+}
+
+std::size_t vkx::Archetype::chunkSize(std::size_t chunk) const noexcept {
+	return chunks[chunk].entities.size();
+}
+
+const vkx::Entity* vkx::Archetype::entities(std::size_t chunk) const noexcept {
+	return chunks[chunk].entities.data();
+}
+
+std::byte* vkx::Archetype::column(std::size_t chunk, std::uint32_t component) const noexcept {
+	return reinterpret_cast<std::byte*>(chunks[chunk].memory.get()) + offsets[component];
+}
+
+std::byte* vkx::Archetype::component(std::size_t row, std::uint32_t id) const noexcept {
+	return column(row / capacity, id) + row % capacity * sizes[id];
+}
+
+std::size_t vkx::Archetype::push(const vkx::Entity& entity) {
+	const auto chunk = count / capacity;
+	if (chunk == chunks.size()) {
+		// Chunks are kept once allocated, an archetype that shrinks and grows again reuses them.
+		auto& created = chunks.emplace_back();
+		created.memory = std::make_unique<std::max_align_t[]>((chunkBytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+		created.entities.reserve(capacity);
+	}
+
+	chunks[chunk].entities.push_back(entity);
+	return count++;
+}
+
+std::optional<vkx::Entity> vkx::Archetype::swapRemove(std::size_t row) {
+	const auto last = count - 1;
+	auto& lastEntities = chunks[last / capacity].entities;
+	const auto moved = lastEntities.back();
+
+	if (row != last) {
+		for (const auto id : components) {
+			std::memcpy(component(row, id), component(last, id), sizes[id]);
+		}
+
+		chunks[row / capacity].entities[row % capacity] = moved;
+	}
+
+	lastEntities.pop_back();
+	count--;
+
+	if (row == last) {
+		return std::nullopt;
+	}
+
+	return moved;
+}
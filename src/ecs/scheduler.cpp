@@ -0,0 +1,46 @@
+#include <vkx/ecs/scheduler.hpp>
+#include <vkx/profiler.hpp>
+
+void vkx::SystemScheduler::add(const char* name, vkx::ComponentMask reads, vkx::ComponentMask writes, std::function<void(vkx::World&)> system) {
+	const auto index = systems.size();
+	systems.push_back(System{name, reads, writes, std::move(system)});
+
+	// The system goes right after the last stage holding a system it conflicts with.
+	auto stage = stages.size();
+	while (stage > 0 && std::none_of(stages[stage - 1].begin(), stages[stage - 1].end(), [this, index](std::size_t other) {
+		       return conflicts(systems[index], systems[other]);
+	       })) {
+		stage--;
+	}
+
+	if (stage == stages.size()) {
+		stages.emplace_back();
+	}
+
+	stages[stage].push_back(index);
+}
+
+void vkx::SystemScheduler::run(vkx::World& world, vkx::ThreadPool& pool) {
+	for (const auto& stage : stages) {
+		if (stage.size() == 1) {
+			const auto& system = systems[stage.front()];
+			VKX_PROFILE_ZONE(system.name);
+			system.run(world);
+			continue;
+		}
+
+		pool.run(stage.size(), [this, &stage, &world](std::size_t i) {
+			const auto& system = systems[stage[i]];
+			VKX_PROFILE_ZONE(system.name);
+			system.run(world);
+		});
+	}
+}
+
+const std::vector<std::vector<std::size_t>>& vkx::SystemScheduler::getStages() const noexcept {
+	return stages;
+}
+
+bool vkx::SystemScheduler::conflicts(const System& first, const System& second) noexcept {
+	return (first.writes & (second.reads | second.writes)) != 0 || (second.writes & first.reads) != 0;
+}
@@ -0,0 +1,112 @@
+#include <vkx/ecs/world.hpp>
+
+vkx::World::World() {
+	// Entities without components live in the empty archetype.
+	archetypeFor(0);
+}
+
+void vkx::World::destroy(const vkx::Entity& entity) {
+	auto& record = recordOf(entity);
+	removeRow(record);
+
+	record.alive = false;
+	record.generation++;
+	freeIndices.push_back(entity.index);
+	aliveCount--;
+}
+
+bool vkx::World::isAlive(const vkx::Entity& entity) const noexcept {
+	return entity.index < records.size() && records[entity.index].alive && records[entity.index].generation == entity.generation;
+}
+
+std::size_t vkx::World::size() const noexcept {
+	return aliveCount;
+}
+
+std::size_t vkx::World::archetypeCount() const noexcept {
+	return archetypes.size();
+}
+
+vkx::Entity vkx::World::allocate(vkx::ComponentMask mask) {
+	std::uint32_t index = 0;
+	if (freeIndices.empty()) {
+		index = static_cast<std::uint32_t>(records.size());
+		records.emplace_back();
+	} else {
+		index = freeIndices.back();
+		freeIndices.pop_back();
+	}
+
+	auto& record = records[index];
+	const vkx::Entity entity{index, record.generation};
+
+	record.archetype = archetypeFor(mask);
+	record.row = archetypes[record.archetype]->push(entity);
+	record.alive = true;
+	aliveCount++;
+
+	return entity;
+}
+
+const vkx::World::Record& vkx::World::recordOf(const vkx::Entity& entity) const {
+	if (!isAlive(entity)) {
+		throw std::runtime_error("Entity was destroyed.");
+	}
+
+	return records[entity.index];
+}
+
+vkx::World::Record& vkx::World::recordOf(const vkx::Entity& entity) {
+	if (!isAlive(entity)) {
+		throw std::runtime_error("Entity was destroyed.");
+	}
+
+	return records[entity.index];
+}
+
+vkx::ComponentMask vkx::World::maskOf(const vkx::Entity& entity) const {
+	return archetypes[recordOf(entity).archetype]->getMask();
+}
+
+std::byte* vkx::World::component(const vkx::Entity& entity, std::uint32_t id) const {
+	const auto& record = recordOf(entity);
+	return archetypes[record.archetype]->component(record.row, id);
+}
+
+std::uint32_t vkx::World::archetypeFor(vkx::ComponentMask mask) {
+	const auto [iter, inserted] = archetypeIndices.try_emplace(mask, static_cast<std::uint32_t>(archetypes.size()));
+	if (inserted) {
+		archetypes.push_back(std::make_unique<vkx::Archetype>(mask));
+	}
+
+	return iter->second;
+}
+
+void vkx::World::move(const vkx::Entity& entity, vkx::ComponentMask mask) {
+	auto& record = recordOf(entity);
+	const auto* from = archetypes[record.archetype].get();
+	if (from->getMask() == mask) {
+		return;
+	}
+
+	const auto target = archetypeFor(mask);
+	auto* to = archetypes[target].get();
+
+	const auto row = to->push(entity);
+	for (const auto id : from->getComponents()) {
+		if (mask & (vkx::ComponentMask{1} << id)) {
+			std::memcpy(to->component(row, id), from->component(record.row, id), from->componentSize(id));
+		}
+	}
+
+	removeRow(record);
+	record.archetype = target;
+	record.row = row;
+}
+
+void vkx::World::removeRow(const Record& record) {
+	const auto moved = archetypes[record.archetype]->swapRemove(record.row);
+	if (moved) {
+		records[moved->index].row = record.row;
+	}
+}
@@ -0,0 +1,95 @@
+#include <vkx/physics/physics_world.hpp>
+
+vkx::PhysicsWorld::PhysicsWorld(float cellSize)
+    : hash(cellSize) {
+}
+
+std::uint32_t vkx::PhysicsWorld::add(const vkx::Body& body) {
+	bodies.push_back(body);
+	return static_cast<std::uint32_t>(bodies.size() - 1);
+}
+
+vkx::Body& vkx::PhysicsWorld::get(std::uint32_t body) {
+	return bodies.at(body);
+}
+
+const vkx::Body& vkx::PhysicsWorld::get(std::uint32_t body) const {
+	return bodies.at(body);
+}
+
+std::size_t vkx::PhysicsWorld::size() const noexcept {
+	return bodies.size();
+}
+
+const std::vector<vkx::Contact>& vkx::PhysicsWorld::getContacts() const noexcept {
+	return contacts;
+}
+
+void vkx::PhysicsWorld::updateHash() {
+	for (std::size_t i = 0; i < bodies.size(); i++) {
+		const auto& body = bodies[i];
+		hash.update(static_cast<std::uint32_t>(i), body.position, body.position + body.size);
+	}
+}
+
+void vkx::PhysicsWorld::findContacts(vkx::ThreadPool& pool) {
+	const auto& cells = hash.occupiedCells();
+	const auto taskCount = (cells.size() + CELLS_PER_TASK - 1) / CELLS_PER_TASK;
+	if (taskContacts.size() < taskCount) {
+		taskContacts.resize(taskCount);
+	}
+
+	pool.run(taskCount, [this, &cells](std::size_t task) {
+		auto& found = taskContacts[task];
+		found.clear();
+
+		const auto end = std::min(cells.size(), (task + 1) * CELLS_PER_TASK);
+		for (auto c = task * CELLS_PER_TASK; c < end; c++) {
+			const auto& cell = cells[c];
+			for (std::size_t i = 0; i < cell.bodies.size(); i++) {
+				for (auto j = i + 1; j < cell.bodies.size(); j++) {
+					const auto a = std::min(cell.bodies[i], cell.bodies[j]);
+					const auto b = std::max(cell.bodies[i], cell.bodies[j]);
+					const auto& first = bodies[a];
+					const auto& second = bodies[b];
+
+					const auto overlapMin = glm::max(first.position, second.position);
+					const auto overlapMax = glm::min(first.position + first.size, second.position + second.size);
+					if (overlapMin.x >= overlapMax.x || overlapMin.y >= overlapMax.y) {
+						continue;
+					}
+
+					// Pairs sharing several cells are only reported by the cell holding the corner of their overlap.
+					if (hash.cellCoordinate(overlapMin) != cell.coordinate) {
+						continue;
+					}
+
+					// Separate along the axis of least overlap, away from the other body's center.
+					const auto overlap = overlapMax - overlapMin;
+					const auto offset = (second.position + second.size * 0.5f) - (first.position + first.size * 0.5f);
+					const glm::length_t axis = overlap.x < overlap.y ? 0 : 1;
+
+					glm::vec2 normal{0};
+					normal[axis] = offset[axis] < 0.0f ? -1.0f : 1.0f;
+					found.push_back(vkx::Contact{a, b, normal, overlap[axis]});
+				}
+			}
+		}
+	});
+
+	contacts.clear();
+	for (std::size_t task = 0; task < taskCount; task++) {
+		contacts.insert(contacts.end(), taskContacts[task].begin(), taskContacts[task].end());
+	}
+
+	std::sort(contacts.begin(), contacts.end(), [](const vkx::Contact& left, const vkx::Contact& right) {
+		return left.a != right.a ? left.a < right.a : left.b < right.b;
+	});
+
+	pushes.assign(bodies.size(), glm::vec2{0});
+	for (const auto& contact : contacts) {
+		const auto push = contact.normal * (contact.depth * 0.5f);
+		pushes[contact.a] -= push;
+		pushes[contact.b] += push;
+	}
+}
@@ -0,0 +1,92 @@
+#include <vkx/physics/spatial_hash.hpp>
+
+vkx::SpatialHash::SpatialHash(float cellSize)
+    : cellSize(cellSize) {
+	if (cellSize <= 0.0f) {
+		throw std::runtime_error("Spatial hash cells must have a positive size.");
+	}
+}
+
+float vkx::SpatialHash::getCellSize() const noexcept {
+	return cellSize;
+}
+
+glm::ivec2 vkx::SpatialHash::cellCoordinate(const glm::vec2& position) const noexcept {
+	return glm::ivec2{glm::floor(position / cellSize)};
+}
+
+void vkx::SpatialHash::update(std::uint32_t body, const glm::vec2& min, const glm::vec2& max) {
+	if (body >= ranges.size()) {
+		ranges.resize(body + 1);
+	}
+
+	const CellRange range{cellCoordinate(min), cellCoordinate(max)};
+	auto& current = ranges[body];
+	if (range.min == current.min && range.max == current.max) {
+		return;
+	}
+
+	erase(body, current);
+	insert(body, range);
+	current = range;
+}
+
+void vkx::SpatialHash::remove(std::uint32_t body) {
+	if (body >= ranges.size()) {
+		return;
+	}
+
+	erase(body, ranges[body]);
+	ranges[body] = CellRange{};
+}
+
+const std::vector<vkx::SpatialHash::Cell>& vkx::SpatialHash::occupiedCells() const noexcept {
+	return cells;
+}
+
+std::uint64_t vkx::SpatialHash::key(const glm::ivec2& coordinate) noexcept {
+	return static_cast<std::uint64_t>(static_cast<std::uint32_t>(coordinate.x)) << 32 | static_cast<std::uint32_t>(coordinate.y);
+}
+
+void vkx::SpatialHash::insert(std::uint32_t body, const CellRange& range) {
+	for (auto y = range.min.y; y <= range.max.y; y++) {
+		for (auto x = range.min.x; x <= range.max.x; x++) {
+			const glm::ivec2 coordinate{x, y};
+			const auto [iter, inserted] = cellIndices.try_emplace(key(coordinate), cells.size());
+			if (inserted) {
+				cells.push_back(Cell{coordinate, {}});
+			}
+
+			cells[iter->second].bodies.push_back(body);
+		}
+	}
+}
+
+void vkx::SpatialHash::erase(std::uint32_t body, const CellRange& range) {
+	for (auto y = range.min.y; y <= range.max.y; y++) {
+		for (auto x = range.min.x; x <= range.max.x; x++) {
+			const auto iter = cellIndices.find(key(glm::ivec2{x, y}));
+			if (iter == cellIndices.end()) {
+				continue;
+			}
+
+			const auto index = iter->second;
+			auto& bodies = cells[index].bodies;
+			const auto found = std::find(bodies.begin(), bodies.end(), body);
+			if (found != bodies.end()) {
+				*found = bodies.back();
+				bodies.pop_back();
+			}
+
+			// Empty cells are swapped out so occupiedCells stays dense.
+			if (bodies.empty()) {
+				cellIndices.erase(iter);
+				if (index != cells.size() - 1) {
+					cells[index] = std::move(cells.back());
+					cellIndices[key(cells[index].coordinate)] = index;
+				}
+				cells.pop_back();
+			}
+		}
+	}
+}
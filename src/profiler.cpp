@@ -0,0 +1,127 @@
+#include <vkx/profiler.hpp>
+
+namespace {
+// Relaxed atomics, so an export may read a slot while its thread overwrites it.
+struct ZoneSlot {
+	std::atomic<const char*> name{nullptr};
+	std::atomic<std::uint64_t> begin{0};
+	std::atomic<std::uint64_t> end{0};
+};
+
+struct RingBuffer {
+	std::uint32_t threadID = 0;
+	// Zones whose slot was claimed for writing, ahead of written while a zone is being written.
+	std::atomic<std::uint64_t> claimed{0};
+	std::atomic<std::uint64_t> written{0};
+	std::array<ZoneSlot, vkx::profiler::RING_CAPACITY> zones{};
+};
+
+struct Calibration {
+	std::uint64_t ticks = vkx::profiler::ticks();
+	std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+};
+
+const Calibration calibration{};
+
+std::mutex registryMutex{};
+std::vector<std::unique_ptr<RingBuffer>> registry{};
+
+// Buffers are owned by the registry so zones of finished threads can still be exported.
+RingBuffer* registerThread() {
+	std::lock_guard<std::mutex> lock{registryMutex};
+
+	auto& buffer = registry.emplace_back(std::make_unique<RingBuffer>());
+	buffer->threadID = static_cast<std::uint32_t>(registry.size());
+
+	return buffer.get();
+}
+
+// Copies the zones the ring holds, dropping the ones its thread overwrote while they were copied.
+std::vector<vkx::profiler::Zone> snapshot(const RingBuffer& buffer) {
+	const auto written = buffer.written.load(std::memory_order_acquire);
+	const auto count = std::min<std::uint64_t>(written, vkx::profiler::RING_CAPACITY);
+
+	std::vector<vkx::profiler::Zone> zones{};
+	zones.reserve(static_cast<std::size_t>(count));
+	for (auto i = written - count; i < written; i++) {
+		const auto& slot = buffer.zones[i % vkx::profiler::RING_CAPACITY];
+		zones.push_back({slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed)});
+	}
+
+	// Pairs with the fence in record, any slot read above that was being rewritten is claimed by now.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const auto claimed = buffer.claimed.load(std::memory_order_relaxed);
+
+	// Zone i shares its slot with zone i + RING_CAPACITY, which is claimed once claimed passes it.
+	const auto firstIntact = claimed > vkx::profiler::RING_CAPACITY ? claimed - vkx::profiler::RING_CAPACITY : 0;
+	if (firstIntact > written - count) {
+		const auto torn = std::min<std::uint64_t>(firstIntact - (written - count), count);
+		zones.erase(zones.begin(), zones.begin() + static_cast<std::ptrdiff_t>(torn));
+	}
+
+	return zones;
+}
+
+void writeEscaped(std::ofstream& file, const char* string) {
+	for (; *string != '\0'; string++) {
+		if (*string == '"' || *string == '\\') {
+			file << '\\';
+		}
+		file << *string;
+	}
+}
+} // namespace
+
+void vkx::profiler::record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept {
+	thread_local RingBuffer* buffer = registerThread();
+
+	const auto index = buffer->written.load(std::memory_order_relaxed);
+
+	// Claimed before the slot is touched, an export that reads any of the new zone sees its slot was claimed.
+	buffer->claimed.store(index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	auto& slot = buffer->zones[index % RING_CAPACITY];
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.begin.store(begin, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+bool vkx::profiler::writeChromeTrace(const std::string& file) {
+	std::ofstream trace{file, std::ios::trunc};
+	if (!trace.is_open()) {
+		return false;
+	}
+
+	const Calibration current{};
+	const std::chrono::duration<double, std::nano> elapsed = current.time - calibration.time;
+	const auto elapsedTicks = static_cast<double>(current.ticks - calibration.ticks);
+	const auto microsecondsPerTick = elapsedTicks > 0.0 ? elapsed.count() / elapsedTicks / 1000.0 : 0.001;
+
+	trace << std::fixed << std::setprecision(3);
+	trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool first = true;
+
+	std::lock_guard<std::mutex> lock{registryMutex};
+	for (const auto& buffer : registry) {
+		// Zones written while exporting may be skipped, the export never blocks the recording threads.
+		for (const auto& zone : snapshot(*buffer)) {
+			if (!first) {
+				trace << ',';
+			}
+			first = false;
+
+			trace << "{\"name\":\"";
+			writeEscaped(trace, zone.name);
+			trace << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadID
+			      << ",\"ts\":" << static_cast<double>(zone.begin - calibration.ticks) * microsecondsPerTick
+			      << ",\"dur\":" << static_cast<double>(zone.end - zone.begin) * microsecondsPerTick << '}';
+		}
+	}
+
+	trace << "]}\n";
+
+	return trace.good();
+}
@@ -15,6 +15,16 @@ void vkx::Buffer::mapMemory(const void* data) const {
 	std::memcpy(mappedData, data, allocationSize);
 }
 
+void vkx::Buffer::mapMemory(const void* data, std::size_t size) const {
+	std::memcpy(mappedData, data, std::min(size, allocationSize));
+}
+
+void vkx::Buffer::mapMemory(const void* data, std::size_t size, std::size_t offset) const {
+	if (offset < allocationSize) {
+		std::memcpy(static_cast<std::byte*>(mappedData) + offset, data, std::min(size, allocationSize - offset));
+	}
+}
+
 vkx::Buffer::operator vk::Buffer() const {
 	return static_cast<vk::Buffer>(buffer);
 }
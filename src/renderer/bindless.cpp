@@ -0,0 +1,73 @@
+#include <vkx/renderer/bindless.hpp>
+#include <vkx/renderer/texture.hpp>
+
+vkx::BindlessTable::BindlessTable(vk::Device logicalDevice)
+    : logicalDevice(logicalDevice) {
+	const std::array bindings{
+	    vk::DescriptorSetLayoutBinding{TEXTURE_BINDING, vk::DescriptorType::eCombinedImageSampler, MAX_TEXTURES, vk::ShaderStageFlagBits::eFragment},
+	    vk::DescriptorSetLayoutBinding{BUFFER_BINDING, vk::DescriptorType::eStorageBuffer, MAX_BUFFERS, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment}};
+
+	// Unwritten entries are never read and entries can be added while the set is bound in pending work.
+	constexpr auto bindingFlags = vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+	const std::array<vk::DescriptorBindingFlags, bindings.size()> flags{bindingFlags, bindingFlags};
+
+	const vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{flags};
+
+	const vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+	    vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+	    bindings,
+	    &bindingFlagsCreateInfo};
+
+	descriptorLayout = logicalDevice.createDescriptorSetLayout(descriptorSetLayoutCreateInfo);
+
+	const std::array poolSizes{
+	    vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, MAX_TEXTURES},
+	    vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, MAX_BUFFERS}};
+
+	const vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo{vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, poolSizes};
+
+	descriptorPool = logicalDevice.createDescriptorPool(descriptorPoolCreateInfo);
+
+	const vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{descriptorPool, descriptorLayout};
+
+	descriptorSet = logicalDevice.allocateDescriptorSets(descriptorSetAllocateInfo)[0];
+}
+
+std::uint32_t vkx::BindlessTable::addTexture(const vkx::Texture& texture) {
+	if (textureCount >= MAX_TEXTURES) {
+		throw std::runtime_error("Bindless texture table is full.");
+	}
+
+	const vk::WriteDescriptorSet write{descriptorSet, TEXTURE_BINDING, textureCount, 1, vk::DescriptorType::eCombinedImageSampler, texture.imageInfo()};
+
+	logicalDevice.updateDescriptorSets(write, {});
+
+	return textureCount++;
+}
+
+std::uint32_t vkx::BindlessTable::addBuffer(const vkx::Buffer& buffer) {
+	if (bufferCount >= MAX_BUFFERS) {
+		throw std::runtime_error("Bindless buffer table is full.");
+	}
+
+	const vk::DescriptorBufferInfo bufferInfo{static_cast<vk::Buffer>(buffer), 0, VK_WHOLE_SIZE};
+
+	const vk::WriteDescriptorSet write{descriptorSet, BUFFER_BINDING, bufferCount, 1, vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfo};
+
+	logicalDevice.updateDescriptorSets(write, {});
+
+	return bufferCount++;
+}
+
+vk::DescriptorSetLayout vkx::BindlessTable::getLayout() const noexcept {
+	return descriptorLayout;
+}
+
+vk::DescriptorSet vkx::BindlessTable::getSet() const noexcept {
+	return descriptorSet;
+}
+
+void vkx::BindlessTable::destroy() {
+	logicalDevice.destroyDescriptorPool(descriptorPool);
+	logicalDevice.destroyDescriptorSetLayout(descriptorLayout);
+}
@@ -0,0 +1,184 @@
+#include <vkx/renderer/gpu_profiler.hpp>
+
+vkx::GPUProfiler::GPUProfiler(vk::PhysicalDevice physicalDevice, vk::Device logicalDevice, std::uint32_t queueFamilyIndex, std::uint32_t maxScopes)
+    : logicalDevice(logicalDevice), maxScopes(maxScopes) {
+	const auto validBits = physicalDevice.getQueueFamilyProperties()[queueFamilyIndex].timestampValidBits;
+	if (validBits == 0) {
+		return;
+	}
+
+	timestampPeriod = physicalDevice.getProperties().limits.timestampPeriod;
+	timestampMask = validBits >= 64 ? UINT64_MAX : (UINT64_C(1) << validBits) - 1;
+
+	const vk::QueryPoolCreateInfo queryPoolCreateInfo{
+	    {},
+	    vk::QueryType::eTimestamp,
+	    maxScopes * 2};
+
+	slots.resize(SLOT_COUNT);
+	for (auto& slot : slots) {
+		slot.queryPool = logicalDevice.createQueryPool(queryPoolCreateInfo);
+		slot.scopes.reserve(maxScopes);
+	}
+}
+
+void vkx::GPUProfiler::destroy() {
+	for (const auto& slot : slots) {
+		logicalDevice.destroyQueryPool(slot.queryPool);
+	}
+	slots.clear();
+}
+
+bool vkx::GPUProfiler::isSupported() const noexcept {
+	return !slots.empty();
+}
+
+void vkx::GPUProfiler::beginFrame(vk::CommandBuffer commandBuffer, std::uint32_t slot) {
+	if (!isSupported()) {
+		return;
+	}
+
+	resolve(slot);
+
+	commandBuffer.resetQueryPool(slots[slot].queryPool, 0, maxScopes * 2);
+}
+
+std::uint32_t vkx::GPUProfiler::beginScope(vk::CommandBuffer commandBuffer, std::uint32_t slot, const char* label) {
+	if (!isSupported()) {
+		return NO_SCOPE;
+	}
+
+	auto& current = slots[slot];
+	if (current.scopes.size() >= maxScopes) {
+		return NO_SCOPE;
+	}
+
+	const auto scope = static_cast<std::uint32_t>(current.scopes.size());
+	current.scopes.push_back(labelIndex(label));
+
+	commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, current.queryPool, scope * 2);
+
+	return scope;
+}
+
+void vkx::GPUProfiler::endScope(vk::CommandBuffer commandBuffer, std::uint32_t slot, std::uint32_t scope) const {
+	if (scope == NO_SCOPE) {
+		return;
+	}
+
+	commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, slots[slot].queryPool, scope * 2 + 1);
+}
+
+void vkx::GPUProfiler::resolve(std::uint32_t slot) {
+	if (!isSupported()) {
+		return;
+	}
+
+	auto& current = slots[slot];
+	if (current.scopes.empty()) {
+		return;
+	}
+
+	// Every query is followed by its availability word, unavailable pairs are dropped instead of waited on.
+	const auto queryCount = static_cast<std::uint32_t>(current.scopes.size() * 2);
+	std::vector<std::uint64_t> results(queryCount * 2);
+
+	const auto result = vkGetQueryPoolResults(logicalDevice,
+						  current.queryPool,
+						  0,
+						  queryCount,
+						  results.size() * sizeof(std::uint64_t),
+						  results.data(),
+						  2 * sizeof(std::uint64_t),
+						  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+	if (result == VK_SUCCESS || result == VK_NOT_READY) {
+		for (std::size_t i = 0; i < current.scopes.size(); i++) {
+			const auto begin = results[i * 4];
+			const auto beginAvailable = results[i * 4 + 1];
+			const auto end = results[i * 4 + 2];
+			const auto endAvailable = results[i * 4 + 3];
+
+			if (!beginAvailable || !endAvailable) {
+				continue;
+			}
+
+			const auto ticks = (end - begin) & timestampMask;
+			const auto milliseconds = static_cast<float>(static_cast<double>(ticks) * timestampPeriod / 1000000.0);
+
+			auto& history = histories[current.scopes[i]];
+			history.samples[history.next] = milliseconds;
+			history.next = (history.next + 1) % HISTORY_SIZE;
+			history.count = std::min(history.count + 1, HISTORY_SIZE);
+			history.resolved++;
+		}
+	}
+
+	current.scopes.clear();
+}
+
+std::uint32_t vkx::GPUProfiler::acquireUploadSlot() {
+	if (!isSupported()) {
+		return NO_SLOT;
+	}
+
+	for (auto slot = vkx::MAX_FRAMES_IN_FLIGHT; slot < SLOT_COUNT; slot++) {
+		if (!slots[slot].acquired) {
+			slots[slot].acquired = true;
+			return slot;
+		}
+	}
+
+	return NO_SLOT;
+}
+
+void vkx::GPUProfiler::releaseUploadSlot(std::uint32_t slot, bool submitted) {
+	if (slot == NO_SLOT) {
+		return;
+	}
+
+	auto& current = slots[slot];
+	if (submitted) {
+		resolve(slot);
+	}
+
+	current.scopes.clear();
+	current.acquired = false;
+}
+
+vkx::GPUTimings vkx::GPUProfiler::timings(const std::string& label) const {
+	const auto iter = std::find(labels.cbegin(), labels.cend(), label);
+	if (iter == labels.cend()) {
+		return {};
+	}
+
+	const auto& history = histories[static_cast<std::size_t>(std::distance(labels.cbegin(), iter))];
+	if (history.count == 0) {
+		return {};
+	}
+
+	const auto begin = history.samples.cbegin();
+	const auto end = begin + history.count;
+	const auto [minimum, maximum] = std::minmax_element(begin, end);
+	const auto sum = std::accumulate(begin, end, 0.0f);
+
+	const auto latest = history.samples[(history.next + HISTORY_SIZE - 1) % HISTORY_SIZE];
+
+	return vkx::GPUTimings{*minimum, sum / static_cast<float>(history.count), *maximum, latest, history.count, history.resolved};
+}
+
+const std::vector<std::string>& vkx::GPUProfiler::getLabels() const noexcept {
+	return labels;
+}
+
+std::size_t vkx::GPUProfiler::labelIndex(const char* label) {
+	const auto iter = std::find(labels.cbegin(), labels.cend(), label);
+	if (iter != labels.cend()) {
+		return static_cast<std::size_t>(std::distance(labels.cbegin(), iter));
+	}
+
+	labels.emplace_back(label);
+	histories.emplace_back();
+
+	return labels.size() - 1;
+}
@@ -3,7 +3,7 @@
 vkx::Image::Image(vk::Device logicalDevice, VmaAllocator allocator, VkImage image, VmaAllocation allocation)
     : logicalDevice(logicalDevice), allocator(allocator), resourceImage(image), resourceAllocation(allocation) {}
 
-vkx::Image::Image(vk::Device logicalDevice, VmaAllocator allocator, vk::Extent2D extent, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags imageUsage, VmaAllocationCreateFlags flags, VmaMemoryUsage memoryUsage)
+vkx::Image::Image(vk::Device logicalDevice, VmaAllocator allocator, vk::Extent2D extent, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags imageUsage, std::uint32_t mipLevels, std::uint32_t arrayLayers, VmaAllocationCreateFlags flags, VmaMemoryUsage memoryUsage)
 	: logicalDevice(logicalDevice), 
 	allocator(allocator) {
 	const vk::Extent3D imageExtent{extent.width, extent.height, 1};
@@ -13,8 +13,8 @@ vkx::Image::Image(vk::Device logicalDevice, VmaAllocator allocator, vk::Extent2D
 	    vk::ImageType::e2D,
 	    format,
 	    imageExtent,
-	    1,
-	    1,
+	    mipLevels,
+	    arrayLayers,
 	    vk::SampleCountFlagBits::e1,
 	    tiling,
 	    imageUsage,
@@ -43,18 +43,18 @@ void vkx::Image::destroy() const {
 	vmaDestroyImage(allocator, resourceImage, resourceAllocation);
 }
 
-vk::ImageView vkx::Image::createView(vk::Format format, vk::ImageAspectFlags aspectFlags) const {
+vk::ImageView vkx::Image::createView(vk::Format format, vk::ImageAspectFlags aspectFlags, vk::ImageViewType viewType, std::uint32_t mipLevels, std::uint32_t arrayLayers) const {
 	const vk::ImageSubresourceRange subresourceRange{
 	    aspectFlags,
 	    0,
-	    1,
+	    mipLevels,
 	    0,
-	    1};
+	    arrayLayers};
 
 	const vk::ImageViewCreateInfo imageViewCreateInfo{
 	    {},
 	    resourceImage,
-	    vk::ImageViewType::e2D,
+	    viewType,
 	    format,
 	    {},
 	    subresourceRange};
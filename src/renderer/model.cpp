@@ -6,14 +6,99 @@ vkx::Mesh::Mesh(std::vector<vkx::Vertex>&& vertices, std::vector<std::uint32_t>&
       indexBuffer(instance.allocateBuffer(indices.size() * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eIndexBuffer)),
       vertices(std::move(vertices)),
       indices(std::move(indices)),
-      activeIndexCount(activeIndexCount) {
-	vertexBuffer.mapMemory(vertices.data());
-	indexBuffer.mapMemory(indices.data());
+      activeIndexCount(activeIndexCount),
+      activeVertexCount(this->vertices.size()),
+      uploadedVertexCount(this->vertices.size()),
+      uploadedIndexCount(this->indices.size()) {
+	vertexBuffer.mapMemory(this->vertices.data(), this->vertices.size() * sizeof(vkx::Vertex));
+	indexBuffer.mapMemory(this->indices.data(), this->indices.size() * sizeof(std::uint32_t));
 }
 
 vkx::Mesh::Mesh(std::size_t vertexCount, std::size_t indexCount, const vkx::VulkanInstance& instance)
     : vertexBuffer(instance.allocateBuffer(vertexCount * sizeof(vkx::Vertex), vk::BufferUsageFlagBits::eVertexBuffer)),
       indexBuffer(instance.allocateBuffer(indexCount * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eIndexBuffer)),
       vertices(vertexCount),
-      indices(indexCount) {
+      indices(indexCount),
+      uploadedVertexCount(vertexCount),
+      uploadedIndexCount(indexCount) {
+}
+
+void vkx::mergeRange(std::vector<vkx::MeshRange>& ranges, const vkx::MeshRange& range) {
+	const auto contains = [](const vkx::MeshRange& outer, const vkx::MeshRange& inner) {
+		return outer.firstVertex <= inner.firstVertex && inner.firstVertex + inner.vertexCount <= outer.firstVertex + outer.vertexCount &&
+		       outer.firstIndex <= inner.firstIndex && inner.firstIndex + inner.indexCount <= outer.firstIndex + outer.indexCount;
+	};
+
+	if (std::any_of(ranges.begin(), ranges.end(), [&](const auto& other) { return contains(other, range); })) {
+		return;
+	}
+
+	ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [&](const auto& other) { return contains(range, other); }), ranges.end());
+
+	const auto sameStart = std::find_if(ranges.begin(), ranges.end(), [&range](const auto& other) {
+		return other.firstVertex == range.firstVertex && other.firstIndex == range.firstIndex;
+	});
+	if (sameStart == ranges.end()) {
+		ranges.push_back(range);
+		return;
+	}
+
+	sameStart->vertexCount = std::max(sameStart->vertexCount, range.vertexCount);
+	sameStart->indexCount = std::max(sameStart->indexCount, range.indexCount);
+}
+
+bool vkx::Mesh::isResident() const {
+	return static_cast<vk::Buffer>(vertexBuffer) && static_cast<vk::Buffer>(indexBuffer);
+}
+
+std::size_t vkx::Mesh::makeResident(const vkx::VulkanInstance& instance) {
+	// Empty buffers are invalid, meshes without anything to draw are not made resident anyway.
+	vertexBuffer = instance.allocateBuffer(std::max(activeVertexCount, std::size_t{1}) * sizeof(vkx::Vertex), vk::BufferUsageFlagBits::eVertexBuffer);
+	indexBuffer = instance.allocateBuffer(std::max(activeIndexCount, std::size_t{1}) * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eIndexBuffer);
+	return upload();
+}
+
+std::size_t vkx::Mesh::upload() {
+	if (!isResident()) {
+		return 0;
+	}
+
+	const auto writtenBytes = copyRange(vertexBuffer, indexBuffer, {0, vertices.size(), 0, indices.size()});
+	uploadedVertexCount = std::min(activeVertexCount, vertexBuffer.size() / sizeof(vkx::Vertex));
+	uploadedIndexCount = std::min(activeIndexCount, indexBuffer.size() / sizeof(std::uint32_t));
+	changedRanges.clear();
+	return writtenBytes;
+}
+
+std::size_t vkx::Mesh::copyRange(const vkx::Buffer& vertexDestination, const vkx::Buffer& indexDestination, const vkx::MeshRange& range) const {
+	const auto vertexEnd = std::min({range.firstVertex + range.vertexCount, activeVertexCount, vertexDestination.size() / sizeof(vkx::Vertex)});
+	const auto indexEnd = std::min({range.firstIndex + range.indexCount, activeIndexCount, indexDestination.size() / sizeof(std::uint32_t)});
+
+	std::size_t written = 0;
+	if (range.firstVertex < vertexEnd) {
+		const auto bytes = (vertexEnd - range.firstVertex) * sizeof(vkx::Vertex);
+		vertexDestination.mapMemory(&vertices[range.firstVertex], bytes, range.firstVertex * sizeof(vkx::Vertex));
+		written += bytes;
+	}
+	if (range.firstIndex < indexEnd) {
+		const auto bytes = (indexEnd - range.firstIndex) * sizeof(std::uint32_t);
+		indexDestination.mapMemory(&indices[range.firstIndex], bytes, range.firstIndex * sizeof(std::uint32_t));
+		written += bytes;
+	}
+	return written;
+}
+
+void vkx::Mesh::destroy() {
+	if (isResident()) {
+		vertexBuffer.destroy();
+		indexBuffer.destroy();
+	}
+	for (auto& spare : spareBuffers) {
+		spare.vertexBuffer.destroy();
+		spare.indexBuffer.destroy();
+	}
+
+	vertexBuffer = vkx::Buffer{};
+	indexBuffer = vkx::Buffer{};
+	spareBuffers.clear();
 }
@@ -1,39 +1,199 @@
+#include <vkx/renderer/bindless.hpp>
 #include <vkx/renderer/pipeline.hpp>
 #include <vkx/renderer/texture.hpp>
 
+static const vkx::AssetView& findShader(const vkx::AssetPack& assets, const std::string& name) {
+	const auto* asset = assets.find(name);
+	if (!asset || asset->type != vkx::AssetType::Shader) {
+		throw std::runtime_error("Asset pack has no shader " + name + ".");
+	}
+
+	return *asset;
+}
+
+vk::SpecializationInfo vkx::pipeline::SpecializationConstants::info() const noexcept {
+	return vk::SpecializationInfo{
+	    static_cast<std::uint32_t>(entries.size()),
+	    entries.data(),
+	    data.size() * sizeof(std::uint32_t),
+	    data.data()};
+}
+
+bool vkx::pipeline::SpecializationConstants::empty() const noexcept {
+	return entries.empty();
+}
+
+bool vkx::pipeline::SpecializationConstants::operator==(const SpecializationConstants& other) const {
+	const auto sameID = [](const auto& a, const auto& b) {
+		return a.constantID == b.constantID;
+	};
+
+	return data == other.data && std::equal(entries.begin(), entries.end(), other.entries.begin(), other.entries.end(), sameID);
+}
+
+bool vkx::pipeline::SpecializationConstants::operator!=(const SpecializationConstants& other) const {
+	return !(*this == other);
+}
+
+std::size_t vkx::pipeline::SpecializationConstants::Hash::operator()(const SpecializationConstants& constants) const noexcept {
+	std::size_t hash = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < constants.entries.size(); i++) {
+		hash = (hash ^ constants.entries[i].constantID) * 1099511628211ULL;
+		hash = (hash ^ constants.data[i]) * 1099511628211ULL;
+	}
+
+	return hash;
+}
+
 vkx::pipeline::GraphicsPipeline::GraphicsPipeline(const vkx::VulkanInstance& instance,
 					vk::RenderPass renderPass,
 					const vkx::pipeline::GraphicsPipelineInformation& info)
-	: logicalDevice(instance.logicalDevice) {
+	: logicalDevice(instance.logicalDevice),
+	  renderPass(renderPass),
+	  bindingDescriptions(info.bindingDescriptions),
+	  attributeDescriptions(info.attributeDescriptions) {
 	const vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{{}, info.bindings};
 
 	descriptorLayout = logicalDevice.createDescriptorSetLayout(descriptorSetLayoutCreateInfo);
 
-	const vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo{{}, descriptorLayout};
+	if (info.bindless) {
+		bindlessSet = info.bindless->getSet();
+
+		const std::array setLayouts{descriptorLayout, info.bindless->getLayout()};
+
+		const vk::PushConstantRange pushConstantRange{vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(vkx::BindlessDrawIndices)};
+
+		const vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo{{}, setLayouts, pushConstantRange};
+
+		pipelineLayout = logicalDevice.createPipelineLayout(pipelineLayoutCreateInfo);
+	} else {
+		const vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo{{}, descriptorLayout};
+
+		pipelineLayout = logicalDevice.createPipelineLayout(pipelineLayoutCreateInfo);
+	}
+
+	if (info.assets) {
+		vertexShaderModule = createShaderModule(findShader(*info.assets, info.vertexFile)).release();
+		fragmentShaderModule = createShaderModule(findShader(*info.assets, info.fragmentFile)).release();
+	} else {
+		vertexShaderModule = createShaderModule(info.vertexFile).release();
+		fragmentShaderModule = createShaderModule(info.fragmentFile).release();
+	}
+
+	pipeline = getVariant(info.constants);
+
+	std::vector<vk::DescriptorPoolSize> poolSizes{};
+	poolSizes.reserve(info.bindings.size());
+	for (const auto& info : info.bindings) {
+		poolSizes.emplace_back(info.descriptorType, vkx::MAX_FRAMES_IN_FLIGHT);
+	}
+
+	const vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo{{}, vkx::MAX_FRAMES_IN_FLIGHT, poolSizes};
+
+	descriptorPool = logicalDevice.createDescriptorPool(descriptorPoolCreateInfo);
 
-	pipelineLayout = logicalDevice.createPipelineLayout(pipelineLayoutCreateInfo);
+	const std::vector layouts{vkx::MAX_FRAMES_IN_FLIGHT, descriptorLayout};
+
+	const vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{descriptorPool, layouts};
 
-	const auto vertShaderModule = createShaderModule(info.vertexFile);
-	const auto fragShaderModule = createShaderModule(info.fragmentFile);
+	descriptorSets = logicalDevice.allocateDescriptorSets(descriptorSetAllocateInfo);
+
+	for (std::size_t size : info.uniformSizes) {
+		uniforms.push_back(instance.allocateUniformBuffers(size, vkx::MAX_FRAMES_IN_FLIGHT));
+	}
+
+	for (std::uint32_t i = 0; i < vkx::MAX_FRAMES_IN_FLIGHT; i++) {
+		const auto descriptorSet = descriptorSets[i];
+
+		auto uniformsBegin = uniforms.cbegin();
+		auto texturesBegin = info.textures.cbegin();
+
+		std::vector<vk::WriteDescriptorSet> writes;
+		writes.reserve(poolSizes.size());
+
+		for (std::uint32_t j = 0; j < poolSizes.size(); j++) {
+			const auto type = poolSizes[j].type;
+
+			const vk::DescriptorBufferInfo* bufferInfo = nullptr;
+			const vk::DescriptorImageInfo* imageInfo = nullptr;
+
+			if (type == vk::DescriptorType::eCombinedImageSampler) {
+				const auto& texture = *texturesBegin;
+				imageInfo = texture->imageInfo();
+				texturesBegin++;
+			} else if (type == vk::DescriptorType::eUniformBuffer) {
+				const auto& uniform = *uniformsBegin;
+				bufferInfo = uniform[i].getInfo();
+				uniformsBegin++;
+			}
+
+			writes.emplace_back(descriptorSet, j, 0, 1, type, imageInfo, bufferInfo);
+		}
+
+		logicalDevice.updateDescriptorSets(writes, {});
+	}
+}
+
+void vkx::pipeline::GraphicsPipeline::destroy() {
+	for (auto& vec : uniforms) {
+		for (auto& uniform : vec) {
+			uniform.buffer.destroy();
+		}
+	}
+
+	logicalDevice.destroyDescriptorSetLayout(descriptorLayout);
+	logicalDevice.destroyPipelineLayout(pipelineLayout);
+	logicalDevice.destroyDescriptorPool(descriptorPool);
+
+	for (const auto& [constants, variant] : variants) {
+		logicalDevice.destroyPipeline(variant);
+	}
+	variants.clear();
+
+	logicalDevice.destroyShaderModule(vertexShaderModule);
+	logicalDevice.destroyShaderModule(fragmentShaderModule);
+}
+
+const std::vector<vkx::UniformBuffer>& vkx::pipeline::GraphicsPipeline::getUniformByIndex(std::size_t i) const {
+	return uniforms[i];
+}
+
+vk::Pipeline vkx::pipeline::GraphicsPipeline::getVariant(const SpecializationConstants& constants) {
+	const auto iter = variants.find(constants);
+	if (iter != variants.end()) {
+		return iter->second;
+	}
+
+	const auto variant = createVariant(constants);
+	variants.emplace(constants, variant);
+
+	return variant;
+}
+
+vk::Pipeline vkx::pipeline::GraphicsPipeline::createVariant(const SpecializationConstants& constants) const {
+	const auto specializationInfo = constants.info();
+	const auto* specialization = constants.empty() ? nullptr : &specializationInfo;
 
 	const vk::PipelineShaderStageCreateInfo vertShaderStageCreateInfo{
 	    {},
 	    vk::ShaderStageFlagBits::eVertex,
-	    *vertShaderModule,
-	    "main"};
+	    vertexShaderModule,
+	    "main",
+	    specialization};
 
 	const vk::PipelineShaderStageCreateInfo fragShaderStageCreateInfo{
 	    {},
 	    vk::ShaderStageFlagBits::eFragment,
-	    *fragShaderModule,
-	    "main"};
+	    fragmentShaderModule,
+	    "main",
+	    specialization};
 
 	const std::vector shaderStages{vertShaderStageCreateInfo, fragShaderStageCreateInfo};
 
 	const vk::PipelineVertexInputStateCreateInfo vertexInputCreateInfo{
 	    {},
-	    info.bindingDescriptions,
-	    info.attributeDescriptions};
+	    bindingDescriptions,
+	    attributeDescriptions};
 
 	const vk::PipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo{
 	    {},
@@ -116,77 +276,12 @@ vkx::pipeline::GraphicsPipeline::GraphicsPipeline(const vkx::VulkanInstance& ins
 	    0,
 	    nullptr};
 
-	if (vkCreateGraphicsPipelines(logicalDevice, nullptr, 1, reinterpret_cast<const VkGraphicsPipelineCreateInfo*>(&graphicsPipelineCreateInfo), nullptr, reinterpret_cast<VkPipeline*>(&pipeline)) != VK_SUCCESS) {
+	vk::Pipeline variant{};
+	if (vkCreateGraphicsPipelines(logicalDevice, nullptr, 1, reinterpret_cast<const VkGraphicsPipelineCreateInfo*>(&graphicsPipelineCreateInfo), nullptr, reinterpret_cast<VkPipeline*>(&variant)) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create pipeline");
 	}
 
-	std::vector<vk::DescriptorPoolSize> poolSizes{};
-	poolSizes.reserve(info.bindings.size());
-	for (const auto& info : info.bindings) {
-		poolSizes.emplace_back(info.descriptorType, vkx::MAX_FRAMES_IN_FLIGHT);
-	}
-
-	const vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo{{}, vkx::MAX_FRAMES_IN_FLIGHT, poolSizes};
-
-	descriptorPool = logicalDevice.createDescriptorPool(descriptorPoolCreateInfo);
-
-	const std::vector layouts{vkx::MAX_FRAMES_IN_FLIGHT, descriptorLayout};
-
-	const vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{descriptorPool, layouts};
-
-	descriptorSets = logicalDevice.allocateDescriptorSets(descriptorSetAllocateInfo);
-
-	for (std::size_t size : info.uniformSizes) {
-		uniforms.push_back(instance.allocateUniformBuffers(size, vkx::MAX_FRAMES_IN_FLIGHT));
-	}
-
-	for (std::uint32_t i = 0; i < vkx::MAX_FRAMES_IN_FLIGHT; i++) {
-		const auto descriptorSet = descriptorSets[i];
-
-		auto uniformsBegin = uniforms.cbegin();
-		auto texturesBegin = info.textures.cbegin();
-
-		std::vector<vk::WriteDescriptorSet> writes;
-		writes.reserve(poolSizes.size());
-
-		for (std::uint32_t j = 0; j < poolSizes.size(); j++) {
-			const auto type = poolSizes[j].type;
-
-			const vk::DescriptorBufferInfo* bufferInfo = nullptr;
-			const vk::DescriptorImageInfo* imageInfo = nullptr;
-
-			if (type == vk::DescriptorType::eCombinedImageSampler) {
-				const auto& texture = *texturesBegin;
-				imageInfo = texture->imageInfo();
-				texturesBegin++;
-			} else if (type == vk::DescriptorType::eUniformBuffer) {
-				const auto& uniform = *uniformsBegin;
-				bufferInfo = uniform[i].getInfo();
-				uniformsBegin++;
-			}
-
-			writes.emplace_back(descriptorSet, j, 0, 1, type, imageInfo, bufferInfo);
-		}
-
-		logicalDevice.updateDescriptorSets(writes, {});
-	}
-}
-
-void vkx::pipeline::GraphicsPipeline::destroy() {
-	for (auto& vec : uniforms) {
-		for (auto& uniform : vec) {
-			uniform.buffer.destroy();
-		}
-	}
-
-	logicalDevice.destroyDescriptorSetLayout(descriptorLayout);
-	logicalDevice.destroyPipelineLayout(pipelineLayout);
-	logicalDevice.destroyDescriptorPool(descriptorPool);
-	logicalDevice.destroyPipeline(pipeline);
-}
-
-const std::vector<vkx::UniformBuffer>& vkx::pipeline::GraphicsPipeline::getUniformByIndex(std::size_t i) const {
-	return uniforms[i];
+	return variant;
 }
 
 vk::UniqueShaderModule vkx::pipeline::GraphicsPipeline::createShaderModule(const std::string& filename) const {
@@ -213,3 +308,13 @@ vk::UniqueShaderModule vkx::pipeline::GraphicsPipeline::createShaderModule(const
 
 	return logicalDevice.createShaderModuleUnique(shaderModuleCreateInfo);
 }
+
+vk::UniqueShaderModule vkx::pipeline::GraphicsPipeline::createShaderModule(const vkx::AssetView& asset) const {
+	// Pack entries are aligned, so the mapped SPIR-V can be handed to the driver in place.
+	const vk::ShaderModuleCreateInfo shaderModuleCreateInfo{
+	    {},
+	    asset.size,
+	    reinterpret_cast<const std::uint32_t*>(asset.data)};
+
+	return logicalDevice.createShaderModuleUnique(shaderModuleCreateInfo);
+}
@@ -10,7 +10,9 @@ vkx::QueueConfig::QueueConfig(vk::PhysicalDevice physicalDevice,
 			graphicsIndex = i;
 		}
 
-		if (physicalDevice.getSurfaceSupportKHR(i, surface)) {
+		// Headless configurations never present, the graphics queue stands in for the present queue.
+		const bool canPresent = surface ? static_cast<bool>(physicalDevice.getSurfaceSupportKHR(i, surface)) : static_cast<bool>(flags & vk::QueueFlagBits::eGraphics);
+		if (canPresent) {
 			presentIndex = i;
 		}
 
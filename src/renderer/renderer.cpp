@@ -1,3 +1,4 @@
+#include <vkx/renderer/bindless.hpp>
 #include <vkx/renderer/buffers.hpp>
 #include <vkx/renderer/commands.hpp>
 #include <vkx/renderer/image.hpp>
@@ -16,20 +17,58 @@ static constexpr std::array<const char*, 0> layers{};
 
 vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
     : window(window) {
-	constexpr vk::ApplicationInfo applicationInfo{
+	const auto instanceExtensions = vkx::getArray<const char*>(
+	    "Failed to enumerate vulkan extensions",
+	    SDL_Vulkan_GetInstanceExtensions,
+	    [](auto result) {
+		    return result != SDL_TRUE;
+	    }, static_cast<SDL_Window*>(window));
+
+	createInstance(instanceExtensions);
+
+	const auto cSurface = vkx::create<VkSurfaceKHR>(
+	    SDL_Vulkan_CreateSurface, [](auto result) {
+		    if (result != SDL_TRUE) {
+			    throw std::runtime_error("Failed to create SDL Vulkan surface.");
+		    }
+	    },
+	    this->window, instance);
+
+	surface = cSurface;
+
+	createDevice();
+}
+
+vkx::VulkanInstance::VulkanInstance(vk::Extent2D offscreenExtent) {
+	createInstance({});
+
+	swapchain.imageExtent = offscreenExtent;
+
+	createDevice();
+}
+
+void vkx::VulkanInstance::createInstance(std::vector<const char*> instanceExtensions) {
+	// Vulkan 1.2 is only requested for descriptor indexing, everything else works on 1.0.
+	if (vk::enumerateInstanceVersion() >= VK_API_VERSION_1_2) {
+		apiVersion = VK_API_VERSION_1_2;
+	}
+
+	const vk::ApplicationInfo applicationInfo{
 	    "VKX",
 	    vkx::VERSION,
 	    "VKX",
 	    vkx::VERSION,
-	    VK_API_VERSION_1_0};
+	    apiVersion};
+
+	// Vulkan 1.0 needs this extension for VK_EXT_memory_budget.
+	for (const auto& extension : vk::enumerateInstanceExtensionProperties()) {
+		if (std::strcmp(extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) {
+			instanceExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+			physicalDeviceProperties2Supported = true;
+		}
+	}
 
 #ifdef DEBUG
-	auto instanceExtensions = vkx::getArray<const char*>(
-	    "Failed to enumerate vulkan extensions",
-	    SDL_Vulkan_GetInstanceExtensions,
-	    [](auto result) {
-		    return result != SDL_TRUE;
-	    }, static_cast<SDL_Window*>(window));
 	instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
 	using Severity = vk::DebugUtilsMessageSeverityFlagBitsEXT;
@@ -49,12 +88,6 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	    debugMessageSeverity,
 	    debugMessageType,
 	    debugCallback};
-
-#else
-	const auto instanceExtensions = vkx::getArray<const char*>(
-	    "Failed to enumerate vulkan extensions",
-	    SDL_Vulkan_GetInstanceExtensions,
-	    [](auto a) { return a != SDL_TRUE; }, static_cast<SDL_Window*>(window));
 #endif
 
 	const vk::InstanceCreateInfo instanceCreateInfo{{}, &applicationInfo, layers, instanceExtensions};
@@ -65,17 +98,9 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 #else
 	instance = vk::createInstance(instanceCreateInfo);
 #endif
+}
 
-	const auto cSurface = vkx::create<VkSurfaceKHR>(
-	    SDL_Vulkan_CreateSurface, [](auto result) {
-		    if (result != SDL_TRUE) {
-			    throw std::runtime_error("Failed to create SDL Vulkan surface.");
-		    }
-	    },
-	    this->window, instance);
-
-	surface = cSurface;
-
+void vkx::VulkanInstance::createDevice() {
 	const auto physicalDevices = instance.enumeratePhysicalDevices();
 
 	vk::PhysicalDevice bestPhysicalDevice = nullptr;
@@ -100,21 +125,71 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	constexpr float queuePriority = 1.0f;
 	const auto queueCreateInfos = queueConfig.createQueueInfos(&queuePriority);
 
+	// Software implementations do not always expose anisotropic filtering.
+	const auto supportedCoreFeatures = physicalDevice.getFeatures();
 	vk::PhysicalDeviceFeatures features{};
-	features.samplerAnisotropy = true;
+	features.samplerAnisotropy = supportedCoreFeatures.samplerAnisotropy;
 
-	constexpr std::array deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+	std::vector<const char*> deviceExtensions{};
+	if (!isHeadless()) {
+		deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+	}
+
+	if (physicalDeviceProperties2Supported) {
+		for (const auto& extension : physicalDevice.enumerateDeviceExtensionProperties()) {
+			if (std::strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) {
+				deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+				memoryBudgetSupported = true;
+			}
+		}
+	}
+
+	vk::PhysicalDeviceVulkan12Features vulkan12Features{};
+	if (apiVersion >= VK_API_VERSION_1_2 && physicalDevice.getProperties().apiVersion >= VK_API_VERSION_1_2) {
+		const auto supportedFeatures = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>().get<vk::PhysicalDeviceVulkan12Features>();
+		const auto properties = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceVulkan12Properties>().get<vk::PhysicalDeviceVulkan12Properties>();
+
+		// The bindless fragment shader indexes its texture and object buffer arrays with values from push constants and buffers.
+		descriptorIndexingSupported = supportedCoreFeatures.shaderSampledImageArrayDynamicIndexing &&
+					      supportedCoreFeatures.shaderStorageBufferArrayDynamicIndexing &&
+					      supportedFeatures.runtimeDescriptorArray &&
+					      supportedFeatures.descriptorBindingPartiallyBound &&
+					      supportedFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+					      supportedFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+					      properties.maxPerStageDescriptorUpdateAfterBindSampledImages >= vkx::BindlessTable::MAX_TEXTURES &&
+					      properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers >= vkx::BindlessTable::MAX_BUFFERS &&
+					      properties.maxDescriptorSetUpdateAfterBindSampledImages >= vkx::BindlessTable::MAX_TEXTURES &&
+					      properties.maxDescriptorSetUpdateAfterBindStorageBuffers >= vkx::BindlessTable::MAX_BUFFERS;
+
+		if (descriptorIndexingSupported) {
+			features.shaderSampledImageArrayDynamicIndexing = true;
+			features.shaderStorageBufferArrayDynamicIndexing = true;
+			vulkan12Features.runtimeDescriptorArray = true;
+			vulkan12Features.descriptorBindingPartiallyBound = true;
+			vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = true;
+			vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = true;
+		}
+	}
 
 	const vk::DeviceCreateInfo deviceCreateInfo{
 	    {},
 	    queueCreateInfos,
 	    layers,
 	    deviceExtensions,
-	    &features};
+	    &features,
+	    descriptorIndexingSupported ? &vulkan12Features : nullptr};
 
 	logicalDevice = physicalDevice.createDevice(deviceCreateInfo);
 
-	maxSamplerAnisotropy = physicalDevice.getProperties().limits.maxSamplerAnisotropy;
+	if (features.samplerAnisotropy) {
+		maxSamplerAnisotropy = physicalDevice.getProperties().limits.maxSamplerAnisotropy;
+	}
+
+	if (isHeadless()) {
+		colorFormat = vk::Format::eR8G8B8A8Unorm;
+	} else {
+		colorFormat = vkx::SwapchainInfo{physicalDevice, surface, window}.surfaceFormat;
+	}
 
 	depthFormat = findSupportedFormat(vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment, {vk::Format::eD32Sfloat, vk::Format::eD32SfloatS8Uint, vk::Format::eD24UnormS8Uint});
 
@@ -123,7 +198,7 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	    &vkGetDeviceProcAddr};
 
 	const VmaAllocatorCreateInfo allocatorCreateInfo{
-	    0,
+	    memoryBudgetSupported ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT : 0,
 	    physicalDevice,
 	    logicalDevice,
 	    0,
@@ -132,7 +207,8 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	    nullptr,
 	    &vulkanFunctions,
 	    instance,
-	    VK_API_VERSION_1_0,
+	    // VMA may only use functions of the version both the instance and the device support.
+	    std::min(apiVersion, physicalDevice.getProperties().apiVersion),
 #ifdef VMA_EXTERNAL_MEMORY
 	    nullptr
 #endif
@@ -147,7 +223,12 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	    },
 	    &allocatorCreateInfo);
 
-	clearRenderPass = createRenderPass();
+	// Offscreen images are copied out or discarded instead of presented.
+	if (isHeadless()) {
+		clearRenderPass = createRenderPass(vk::AttachmentLoadOp::eClear, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferSrcOptimal);
+	} else {
+		clearRenderPass = createRenderPass();
+	}
 
 	swapchain.window = window;
 	swapchain.surface = surface;
@@ -155,11 +236,31 @@ vkx::VulkanInstance::VulkanInstance(SDL_Window* window)
 	swapchain.logicalDevice = logicalDevice;
 	swapchain.allocator = allocator;
 	swapchain.renderPass = clearRenderPass;
+	swapchain.colorFormat = colorFormat;
 	swapchain.depthFormat = depthFormat;
 
 	swapchain.recreate();
 }
 
+bool vkx::VulkanInstance::isHeadless() const noexcept {
+	return !surface;
+}
+
+const vkx::VulkanInstance::Swapchain& vkx::VulkanInstance::getSwapchain() const noexcept {
+	return swapchain;
+}
+
+void vkx::VulkanInstance::recreateSwapchain() {
+	logicalDevice.waitIdle();
+
+	swapchain.destroy();
+	swapchain.recreate();
+}
+
+vk::ResultValue<std::uint32_t> vkx::VulkanInstance::acquireNextImage(const vkx::SyncObjects& syncObjects) const {
+	return swapchain.acquireNextImage(syncObjects);
+}
+
 vk::RenderPass vkx::VulkanInstance::createRenderPass(vk::AttachmentLoadOp loadOp, vk::ImageLayout initialLayout, vk::ImageLayout finalLayout) const {
 	using Sample = vk::SampleCountFlagBits;
 	using Load = vk::AttachmentLoadOp;
@@ -168,11 +269,9 @@ vk::RenderPass vkx::VulkanInstance::createRenderPass(vk::AttachmentLoadOp loadOp
 	using Stage = vk::PipelineStageFlagBits;
 	using Access = vk::AccessFlagBits;
 
-	const vkx::SwapchainInfo swapchainInfo{physicalDevice, surface, window};
-
 	const vk::AttachmentDescription colorAttachment{
 	    {},
-	    swapchainInfo.surfaceFormat,
+	    colorFormat,
 	    Sample::e1,
 	    loadOp,
 	    Store::eStore,
@@ -246,6 +345,20 @@ vkx::CommandSubmitter vkx::VulkanInstance::createCommandSubmitter() const {
 	return vkx::CommandSubmitter{physicalDevice, logicalDevice, surface};
 }
 
+vkx::BindlessTable vkx::VulkanInstance::createBindlessTable() const {
+	if (!descriptorIndexingSupported) {
+		throw std::runtime_error("Bindless descriptors need Vulkan 1.2 descriptor indexing.");
+	}
+
+	return vkx::BindlessTable{logicalDevice};
+}
+
+vkx::GPUProfiler vkx::VulkanInstance::createGPUProfiler() const {
+	const vkx::QueueConfig queueConfig{physicalDevice, surface};
+
+	return vkx::GPUProfiler{physicalDevice, logicalDevice, *queueConfig.graphicsIndex};
+}
+
 vkx::pipeline::GraphicsPipeline vkx::VulkanInstance::createGraphicsPipeline(const vkx::pipeline::GraphicsPipelineInformation& information) const {
 	return vkx::pipeline::GraphicsPipeline{*this, clearRenderPass, information};
 }
@@ -271,12 +384,12 @@ vk::Sampler vkx::VulkanInstance::createTextureSampler() const {
 	    Address::eRepeat,
 	    Address::eRepeat,
 	    {},
-	    true,
+	    maxSamplerAnisotropy > 0.0f,
 	    maxSamplerAnisotropy,
 	    false,
 	    vk::CompareOp::eAlways,
 	    {},
-	    {},
+	    VK_LOD_CLAMP_NONE,
 	    vk::BorderColor::eIntOpaqueBlack,
 	    false};
 
@@ -287,18 +400,18 @@ void vkx::VulkanInstance::waitIdle() const {
 	logicalDevice.waitIdle();
 }
 
-vk::ImageView vkx::VulkanInstance::createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags) const {
+vk::ImageView vkx::VulkanInstance::createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags, vk::ImageViewType viewType, std::uint32_t mipLevels, std::uint32_t arrayLayers) const {
 	const vk::ImageSubresourceRange subresourceRange{
 	    aspectFlags,
 	    0,
-	    1,
+	    mipLevels,
 	    0,
-	    1};
+	    arrayLayers};
 
 	const vk::ImageViewCreateInfo imageViewCreateInfo{
 	    {},
 	    image,
-	    vk::ImageViewType::e2D,
+	    viewType,
 	    format,
 	    {},
 	    subresourceRange};
@@ -306,12 +419,52 @@ vk::ImageView vkx::VulkanInstance::createImageView(vk::Image image, vk::Format f
 	return logicalDevice.createImageView(imageViewCreateInfo);
 }
 
+bool vkx::VulkanInstance::supportsLinearBlit(vk::Format format) const {
+	const auto properties = physicalDevice.getFormatProperties(format);
+	return static_cast<bool>(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+}
+
+bool vkx::VulkanInstance::supportsBindless() const noexcept {
+	return descriptorIndexingSupported;
+}
+
+bool vkx::VulkanInstance::hasMemoryBudget() const noexcept {
+	return memoryBudgetSupported;
+}
+
+std::vector<vkx::MemoryHeapBudget> vkx::VulkanInstance::getMemoryBudgets() const {
+	const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+	vmaGetMemoryProperties(allocator, &memoryProperties);
+
+	std::vector<VmaBudget> budgets{memoryProperties->memoryHeapCount};
+	vmaGetHeapBudgets(allocator, budgets.data());
+
+	std::vector<vkx::MemoryHeapBudget> heapBudgets{};
+	heapBudgets.reserve(budgets.size());
+	for (std::uint32_t i = 0; i < memoryProperties->memoryHeapCount; i++) {
+		const auto& heap = memoryProperties->memoryHeaps[i];
+		heapBudgets.push_back({budgets[i].usage,
+				       budgets[i].budget,
+				       budgets[i].statistics.allocationBytes,
+				       heap.size,
+				       (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0});
+	}
+
+	return heapBudgets;
+}
+
+void vkx::VulkanInstance::setFrameIndex(std::uint32_t frameIndex) const {
+	vmaSetCurrentFrameIndex(allocator, frameIndex);
+}
+
 void vkx::VulkanInstance::destroy() {
 	swapchain.destroy();
 	logicalDevice.destroyRenderPass(clearRenderPass);
 	vmaDestroyAllocator(allocator);
 	logicalDevice.destroy();
-	instance.destroySurfaceKHR(surface);
+	if (surface) {
+		instance.destroySurfaceKHR(surface);
+	}
 	instance.destroy();
 }
 
@@ -345,6 +498,8 @@ vkx::Image vkx::VulkanInstance::allocateImage(vk::Extent2D extent,
 					       vk::Format format,
 					       vk::ImageTiling tiling,
 					       vk::ImageUsageFlags imageUsage,
+					       std::uint32_t mipLevels,
+					       std::uint32_t arrayLayers,
 					       VmaAllocationCreateFlags flags,
 					       VmaMemoryUsage memoryUsage) const {
 	const vk::Extent3D imageExtent{extent.width, extent.height, 1};
@@ -354,8 +509,8 @@ vkx::Image vkx::VulkanInstance::allocateImage(vk::Extent2D extent,
 	    vk::ImageType::e2D,
 	    format,
 	    imageExtent,
-	    1,
-	    1,
+	    mipLevels,
+	    arrayLayers,
 	    vk::SampleCountFlagBits::e1,
 	    tiling,
 	    imageUsage,
@@ -393,10 +548,12 @@ std::uint32_t vkx::VulkanInstance::ratePhysicalDevice(vk::PhysicalDevice physica
 	std::uint32_t rating = 0;
 
 	const vkx::QueueConfig indices{physicalDevice, surface};
-	if (indices.isComplete()) {
-		rating++;
+	if (!indices.isComplete()) {
+		return 0;
 	}
 
+	rating++;
+
 	const auto features = physicalDevice.getFeatures();
 	if (features.samplerAnisotropy) {
 		rating++;
@@ -0,0 +1,214 @@
+#include <vkx/renderer/residency.hpp>
+#include <vkx/profiler.hpp>
+#include <vkx/renderer/renderer.hpp>
+
+namespace {
+// Cuts a range off at the vertices and indices a copy of the buffers holds.
+vkx::MeshRange clampRange(const vkx::MeshRange& range, std::size_t vertexCount, std::size_t indexCount) {
+	const auto clamp = [](std::size_t first, std::size_t count, std::size_t end) {
+		return first < end ? std::min(count, end - first) : 0;
+	};
+
+	return {range.firstVertex, clamp(range.firstVertex, range.vertexCount, vertexCount), range.firstIndex, clamp(range.firstIndex, range.indexCount, indexCount)};
+}
+
+// Leaves room for the mesh to grow by half before its buffers have to be allocated again.
+std::size_t grownCount(std::size_t count, std::size_t maxCount) {
+	return std::min(std::max(count + count / 2, std::size_t{1}), maxCount);
+}
+} // namespace
+
+vkx::ResidencyManager::ResidencyManager(const vkx::VulkanInstance& instance, std::size_t meshCount, std::uint64_t ceiling)
+    : instance(&instance), ceiling(ceiling), lastVisibleFrames(meshCount, 0) {}
+
+void vkx::ResidencyManager::markVisible(std::size_t index) {
+	lastVisibleFrames[index] = frame;
+}
+
+std::size_t vkx::ResidencyManager::update(std::vector<vkx::Mesh>& meshes, std::uint64_t oldestFrameInUse) {
+	VKX_PROFILE_ZONE("residency");
+
+	this->oldestFrameInUse = oldestFrameInUse;
+
+	std::size_t uploadedBytes = 0;
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		auto& mesh = meshes[i];
+		if (frame > SPARE_FRAMES) {
+			retireSpares(mesh, frame - SPARE_FRAMES);
+		}
+
+		if (mesh.activeIndexCount == 0) {
+			// Meshes with nothing to draw hold no buffers.
+			if (mesh.isResident()) {
+				retire(mesh);
+			}
+		} else if (lastVisibleFrames[i] == frame && !mesh.isResident()) {
+			uploadedBytes += mesh.makeResident(*instance);
+		}
+	}
+
+	instance->setFrameIndex(static_cast<std::uint32_t>(frame));
+
+	// Released buffers still count towards the budget until the frames in flight drawing them finish.
+	std::uint64_t pendingBytes = 0;
+	for (const auto& pending : pendingReleases) {
+		pendingBytes += pending.vertexBuffer.size() + pending.indexBuffer.size();
+	}
+
+	auto budgets = instance->getMemoryBudgets();
+	if (underPressure(budgets, pendingBytes)) {
+		// Spares only spare edits an allocation, they go before any mesh is evicted.
+		for (auto& mesh : meshes) {
+			for (const auto& spare : mesh.spareBuffers) {
+				pendingBytes += spare.vertexBuffer.size() + spare.indexBuffer.size();
+			}
+			retireSpares(mesh, frame + 1);
+		}
+	}
+
+	if (underPressure(budgets, pendingBytes)) {
+		std::vector<std::size_t> candidates{};
+		for (std::size_t i = 0; i < meshes.size(); i++) {
+			if (lastVisibleFrames[i] != frame && meshes[i].isResident()) {
+				candidates.push_back(i);
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [this](auto a, auto b) {
+			return lastVisibleFrames[a] < lastVisibleFrames[b];
+		});
+
+		for (const auto index : candidates) {
+			if (!underPressure(budgets, pendingBytes)) {
+				break;
+			}
+
+			auto& mesh = meshes[index];
+			pendingBytes += mesh.vertexBuffer.size() + mesh.indexBuffer.size();
+			retire(mesh);
+		}
+	}
+
+	release(false, oldestFrameInUse);
+
+	frame++;
+
+	return uploadedBytes;
+}
+
+std::size_t vkx::ResidencyManager::reupload(vkx::Mesh& mesh) {
+	// Restoring a mesh uploads all of it.
+	if (!mesh.isResident() || mesh.activeIndexCount == 0) {
+		if (mesh.isResident()) {
+			retire(mesh);
+		}
+		mesh.changedRanges.clear();
+		return 0;
+	}
+
+	const auto fits = [this, &mesh](const vkx::MeshBuffers& spare) {
+		return spare.frame <= oldestFrameInUse && spare.vertexBuffer.size() >= mesh.activeVertexCount * sizeof(vkx::Vertex) &&
+		       spare.indexBuffer.size() >= mesh.activeIndexCount * sizeof(std::uint32_t);
+	};
+
+	vkx::MeshBuffers target{};
+	std::size_t writtenBytes = 0;
+	const auto spare = std::find_if(mesh.spareBuffers.begin(), mesh.spareBuffers.end(), fits);
+	if (spare != mesh.spareBuffers.end()) {
+		target = std::move(*spare);
+		mesh.spareBuffers.erase(spare);
+
+		// The spare misses what changed since it was drawn, what changed now and anything past what it held.
+		auto ranges = std::move(target.staleRanges);
+		for (const auto& range : mesh.changedRanges) {
+			vkx::mergeRange(ranges, range);
+		}
+		for (const auto& range : ranges) {
+			writtenBytes += mesh.copyRange(target.vertexBuffer, target.indexBuffer, clampRange(range, target.vertexCount, target.indexCount));
+		}
+		writtenBytes += mesh.copyRange(target.vertexBuffer, target.indexBuffer, {target.vertexCount, mesh.vertices.size(), target.indexCount, mesh.indices.size()});
+	} else {
+		// Spares no frame draws that the mesh outgrew are replaced by the new copy.
+		retireSpares(mesh, oldestFrameInUse + 1);
+
+		const auto vertexCount = grownCount(mesh.activeVertexCount, mesh.vertices.size());
+		const auto indexCount = grownCount(mesh.activeIndexCount, mesh.indices.size());
+		target.vertexBuffer = instance->allocateBuffer(vertexCount * sizeof(vkx::Vertex), vk::BufferUsageFlagBits::eVertexBuffer);
+		target.indexBuffer = instance->allocateBuffer(indexCount * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eIndexBuffer);
+		writtenBytes += mesh.copyRange(target.vertexBuffer, target.indexBuffer, {0, mesh.vertices.size(), 0, mesh.indices.size()});
+	}
+
+	for (auto& other : mesh.spareBuffers) {
+		for (const auto& range : mesh.changedRanges) {
+			vkx::mergeRange(other.staleRanges, range);
+		}
+	}
+
+	// Frames in flight keep drawing the current buffers, they become a spare once no frame does.
+	mesh.spareBuffers.push_back({std::exchange(mesh.vertexBuffer, target.vertexBuffer), std::exchange(mesh.indexBuffer, target.indexBuffer), mesh.uploadedVertexCount,
+	                             mesh.uploadedIndexCount, std::move(mesh.changedRanges), frame});
+
+	mesh.uploadedVertexCount = mesh.activeVertexCount;
+	mesh.uploadedIndexCount = mesh.activeIndexCount;
+	mesh.changedRanges.clear();
+	return writtenBytes;
+}
+
+std::size_t vkx::ResidencyManager::residentCount(const std::vector<vkx::Mesh>& meshes) const {
+	return static_cast<std::size_t>(std::count_if(meshes.begin(), meshes.end(), [](const auto& mesh) { return mesh.isResident(); }));
+}
+
+std::uint64_t vkx::ResidencyManager::currentFrame() const noexcept {
+	return frame;
+}
+
+void vkx::ResidencyManager::destroy() {
+	release(true, 0);
+}
+
+bool vkx::ResidencyManager::underPressure(const std::vector<vkx::MemoryHeapBudget>& budgets, std::uint64_t pendingBytes) const {
+	std::uint64_t allocationBytes = 0;
+	for (const auto& budget : budgets) {
+		allocationBytes += budget.allocationBytes;
+
+		const auto usage = budget.usage > pendingBytes ? budget.usage - pendingBytes : 0;
+		if (static_cast<double>(usage) > static_cast<double>(budget.budget) * BUDGET_PRESSURE) {
+			return true;
+		}
+	}
+
+	allocationBytes = allocationBytes > pendingBytes ? allocationBytes - pendingBytes : 0;
+	return ceiling != 0 && allocationBytes > ceiling;
+}
+
+void vkx::ResidencyManager::retire(vkx::Mesh& mesh) {
+	pendingReleases.push_back({std::exchange(mesh.vertexBuffer, vkx::Buffer{}), std::exchange(mesh.indexBuffer, vkx::Buffer{}), frame});
+	retireSpares(mesh, frame + 1);
+}
+
+void vkx::ResidencyManager::retireSpares(vkx::Mesh& mesh, std::uint64_t before) {
+	const auto iter = std::remove_if(mesh.spareBuffers.begin(), mesh.spareBuffers.end(), [this, before](auto& spare) {
+		if (spare.frame >= before) {
+			return false;
+		}
+
+		pendingReleases.push_back({spare.vertexBuffer, spare.indexBuffer, spare.frame});
+		return true;
+	});
+
+	mesh.spareBuffers.erase(iter, mesh.spareBuffers.end());
+}
+
+void vkx::ResidencyManager::release(bool all, std::uint64_t oldestFrameInUse) {
+	const auto iter = std::remove_if(pendingReleases.begin(), pendingReleases.end(), [all, oldestFrameInUse](auto& pending) {
+		if (!all && pending.frame > oldestFrameInUse) {
+			return false;
+		}
+
+		pending.vertexBuffer.destroy();
+		pending.indexBuffer.destroy();
+		return true;
+	});
+
+	pendingReleases.erase(iter, pendingReleases.end());
+}
@@ -4,15 +4,37 @@
 
 namespace vkx {
 void VulkanInstance::Swapchain::recreate() {
+	if (surface) {
+		createSwapchainImages();
+	} else {
+		createOffscreenImages();
+	}
+
+	depthImage = vkx::Image{logicalDevice, allocator, imageExtent, depthFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, 1, 1, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT, VMA_MEMORY_USAGE_AUTO};
+	depthImageView = depthImage.createView(depthFormat, vk::ImageAspectFlagBits::eDepth);
+	
+	framebuffers.reserve(imageViews.size());
+	for (const auto& imageView : imageViews) {
+		const std::array framebufferAttachments{imageView, depthImageView};
+
+		const vk::FramebufferCreateInfo framebufferCreateInfo{
+		    {},
+		    renderPass,
+		    framebufferAttachments,
+		    imageExtent.width,
+		    imageExtent.height,
+		    1};
+
+		framebuffers.emplace_back(logicalDevice.createFramebuffer(framebufferCreateInfo));
+	}
+}
+
+void VulkanInstance::Swapchain::createSwapchainImages() {
 	const vkx::SwapchainInfo info{physicalDevice, surface, window};
 	const vkx::QueueConfig config{physicalDevice, surface};
 
 	imageExtent = info.actualExtent;
 
-	int width;
-	int height;
-	SDL_GetWindowSizeInPixels(window, &width, &height);
-
 	const auto imageSharingMode = config.getImageSharingMode();
 
 	const vk::SwapchainCreateInfoKHR swapchainCreateInfo{
@@ -52,23 +74,16 @@ void VulkanInstance::Swapchain::recreate() {
 
 		imageViews.emplace_back(logicalDevice.createImageView(imageViewCreateInfo));
 	}
+}
 
-	depthImage = vkx::Image{logicalDevice, allocator, imageExtent, depthFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT, VMA_MEMORY_USAGE_AUTO};
-	depthImageView = depthImage.createView(depthFormat, vk::ImageAspectFlagBits::eDepth);
-	
-	framebuffers.reserve(imageViews.size());
-	for (const auto& imageView : imageViews) {
-		const std::array framebufferAttachments{imageView, depthImageView};
+void VulkanInstance::Swapchain::createOffscreenImages() {
+	// One target per frame in flight, so frame N + 1 never renders into an image frame N is still using.
+	offscreenImages.reserve(vkx::MAX_FRAMES_IN_FLIGHT);
+	imageViews.reserve(vkx::MAX_FRAMES_IN_FLIGHT);
+	for (std::uint32_t i = 0; i < vkx::MAX_FRAMES_IN_FLIGHT; i++) {
+		const auto& image = offscreenImages.emplace_back(logicalDevice, allocator, imageExtent, colorFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc, 1, 1, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT, VMA_MEMORY_USAGE_AUTO);
 
-		const vk::FramebufferCreateInfo framebufferCreateInfo{
-		    {},
-		    renderPass,
-		    framebufferAttachments,
-		    imageExtent.width,
-		    imageExtent.height,
-		    1};
-
-		framebuffers.emplace_back(logicalDevice.createFramebuffer(framebufferCreateInfo));
+		imageViews.emplace_back(image.createView(colorFormat, vk::ImageAspectFlagBits::eColor));
 	}
 }
 
@@ -76,15 +91,25 @@ void VulkanInstance::Swapchain::destroy() {
 	for (auto& view : imageViews) {
 		logicalDevice.destroyImageView(view);
 	}
+	imageViews.clear();
 	
 	for (auto& framebuffer : framebuffers) {
 		logicalDevice.destroyFramebuffer(framebuffer);
 	}
+	framebuffers.clear();
+
+	for (const auto& image : offscreenImages) {
+		image.destroy();
+	}
+	offscreenImages.clear();
 
 	logicalDevice.destroyImageView(depthImageView);
 	depthImage.destroy();
 	
-	logicalDevice.destroySwapchainKHR(swapchain);
+	if (swapchain) {
+		logicalDevice.destroySwapchainKHR(swapchain);
+		swapchain = nullptr;
+	}
 }
 
 vk::ResultValue<std::uint32_t> VulkanInstance::Swapchain::acquireNextImage(const vkx::SyncObjects& syncObjects) const {
@@ -1,43 +1,88 @@
 #include <vkx/renderer/texture.hpp>
-#include <vkx/renderer/commands.hpp>
+#include <vkx/renderer/upload_batch.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 vkx::Texture::Texture(const std::string& file,
 		      const vkx::VulkanInstance& instance,
-		      const vkx::CommandSubmitter& commandSubmitter)
+		      vkx::UploadBatch& uploadBatch)
+	: Texture(std::vector<std::string>{file}, instance, uploadBatch) {}
+
+vkx::Texture::Texture(const std::vector<std::string>& files,
+		      const vkx::VulkanInstance& instance,
+		      vkx::UploadBatch& uploadBatch)
+	: logicalDevice(instance.logicalDevice),
+	arrayLayers(static_cast<std::uint32_t>(files.size())),
+	sampler(instance.createTextureSampler()) {
+	if (files.empty()) {
+		throw std::invalid_argument("A texture needs at least one layer.");
+	}
+
+	int width = 0;
+	int height = 0;
+	std::vector<std::uint8_t> pixels{};
+	for (const auto& file : files) {
+		int layerWidth;
+		int layerHeight;
+		int channels;
+		stbi_uc* layerPixels = stbi_load(file.c_str(), &layerWidth, &layerHeight, &channels, STBI_rgb_alpha);
+		if (!layerPixels) {
+			throw std::runtime_error("Failed to load texture image!");
+		}
+
+		if (pixels.empty()) {
+			width = layerWidth;
+			height = layerHeight;
+		} else if (layerWidth != width || layerHeight != height) {
+			stbi_image_free(layerPixels);
+			throw std::runtime_error("Texture layers must share the same dimensions.");
+		}
+
+		pixels.insert(pixels.end(), layerPixels, layerPixels + static_cast<std::size_t>(width) * height * STBI_rgb_alpha);
+		stbi_image_free(layerPixels);
+	}
+
+	upload(instance, uploadBatch, pixels.data(), pixels.size(), static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height));
+}
+
+vkx::Texture::Texture(const vkx::AssetView& asset,
+		      const vkx::VulkanInstance& instance,
+		      vkx::UploadBatch& uploadBatch)
 	: logicalDevice(instance.logicalDevice),
+	arrayLayers(asset.layers),
 	sampler(instance.createTextureSampler()) {
-	int width;
-	int height;
-	int channels;
-	stbi_uc* pixels = stbi_load(file.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-	if (!pixels) {
-		throw std::runtime_error("Failed to load texture image!");
+	const auto expectedSize = static_cast<std::size_t>(asset.width) * asset.height * asset.layers * STBI_rgb_alpha;
+	if (asset.type != vkx::AssetType::Texture || asset.layers == 0 || asset.size != expectedSize) {
+		throw std::runtime_error("Asset is not a texture.");
 	}
 
-	auto size = static_cast<vk::DeviceSize>(width) * height * STBI_rgb_alpha;
+	upload(instance, uploadBatch, asset.data, asset.size, asset.width, asset.height);
+}
 
+void vkx::Texture::upload(const vkx::VulkanInstance& instance, vkx::UploadBatch& uploadBatch, const void* pixels, std::size_t size, std::uint32_t width, std::uint32_t height) {
 	const auto staging = instance.allocateBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST);
 
-	staging.mapMemory(pixels);
+	// The allocation may be larger than the pixels, only copy what there is.
+	staging.mapMemory(pixels, size);
 
-	vk::Extent2D extent{static_cast<std::uint32_t>(width), 
-		static_cast<std::uint32_t>(height)};
+	vk::Extent2D extent{width, height};
+
+	if (instance.supportsLinearBlit(FORMAT)) {
+		mipLevels = static_cast<std::uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+	}
 
-	image = instance.allocateImage(extent, vk::Format::eR8G8B8A8Srgb, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled);
+	image = instance.allocateImage(extent, FORMAT, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled, mipLevels, arrayLayers);
 
-	commandSubmitter.transitionImageLayout(static_cast<vk::Image>(image), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+	uploadBatch.transitionImageLayout(static_cast<vk::Image>(image), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels, arrayLayers);
 
-	commandSubmitter.copyBufferToImage(static_cast<vk::Buffer>(staging), static_cast<vk::Image>(image), width, height);
+	uploadBatch.copyBufferToImage(static_cast<vk::Buffer>(staging), static_cast<vk::Image>(image), extent.width, extent.height, arrayLayers);
 
-	commandSubmitter.transitionImageLayout(static_cast<vk::Image>(image), vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+	uploadBatch.generateMipmaps(static_cast<vk::Image>(image), extent.width, extent.height, mipLevels, arrayLayers);
 
-	stbi_image_free(pixels);
-	staging.destroy();
+	uploadBatch.addStagingBuffer(staging);
 
-	view = image.createView(vk::Format::eR8G8B8A8Srgb, vk::ImageAspectFlagBits::eColor);
+	view = image.createView(FORMAT, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2DArray, mipLevels, arrayLayers);
 
 	descriptorImageInfo = {sampler, view, vk::ImageLayout::eShaderReadOnlyOptimal};
 }
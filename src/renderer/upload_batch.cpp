@@ -0,0 +1,238 @@
+#include <vkx/renderer/upload_batch.hpp>
+
+vkx::UploadBatch::UploadBatch(vk::Device logicalDevice, vk::CommandPool commandPool, vk::Queue graphicsQueue, vkx::GPUProfiler* profiler)
+    : logicalDevice(logicalDevice), commandPool(commandPool), graphicsQueue(graphicsQueue), profiler(profiler) {
+	const vk::CommandBufferAllocateInfo commandBufferAllocateInfo{
+	    commandPool,
+	    vk::CommandBufferLevel::ePrimary,
+	    1};
+
+	commandBuffer = logicalDevice.allocateCommandBuffers(commandBufferAllocateInfo)[0];
+
+	fence = logicalDevice.createFence({});
+
+	const vk::CommandBufferBeginInfo commandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit};
+
+	commandBuffer.begin(commandBufferBeginInfo);
+
+	if (profiler) {
+		profilerSlot = profiler->acquireUploadSlot();
+	}
+
+	// Batches beyond the upload slots are not timed.
+	if (profilerSlot != vkx::GPUProfiler::NO_SLOT) {
+		profiler->beginFrame(commandBuffer, profilerSlot);
+		profilerScope = profiler->beginScope(commandBuffer, profilerSlot, "upload");
+	}
+}
+
+void vkx::UploadBatch::transitionImageLayout(vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, std::uint32_t mipLevels, std::uint32_t arrayLayers) const {
+	const vk::ImageSubresourceRange subresourceRange{
+	    vk::ImageAspectFlagBits::eColor,
+	    0,
+	    mipLevels,
+	    0,
+	    arrayLayers};
+
+	vk::AccessFlags srcAccessMask{};
+	vk::AccessFlags dstAccessMask{};
+
+	vk::PipelineStageFlags sourceStage{};
+	vk::PipelineStageFlags destinationStage{};
+
+	if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eTransferDstOptimal) {
+		srcAccessMask = {};
+		dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+
+		sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
+		destinationStage = vk::PipelineStageFlagBits::eTransfer;
+	} else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal) {
+		srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+		dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+		sourceStage = vk::PipelineStageFlagBits::eTransfer;
+		destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
+	} else {
+		throw std::invalid_argument("Unsupported layout transition.");
+	}
+
+	const vk::ImageMemoryBarrier barrier{
+	    srcAccessMask,
+	    dstAccessMask,
+	    oldLayout,
+	    newLayout,
+	    VK_QUEUE_FAMILY_IGNORED,
+	    VK_QUEUE_FAMILY_IGNORED,
+	    image,
+	    subresourceRange};
+
+	commandBuffer.pipelineBarrier(sourceStage, destinationStage, {}, {}, {}, barrier);
+}
+
+void vkx::UploadBatch::copyBufferToImage(vk::Buffer buffer, vk::Image image, std::uint32_t width, std::uint32_t height, std::uint32_t arrayLayers) const {
+	const vk::ImageSubresourceLayers subresourceLayer{
+	    vk::ImageAspectFlagBits::eColor,
+	    0,
+	    0,
+	    arrayLayers};
+
+	const vk::Offset3D imageOffset{
+	    0,
+	    0,
+	    0};
+
+	const vk::Extent3D imageExtent{
+	    width,
+	    height,
+	    1};
+
+	const vk::BufferImageCopy region{
+	    0,
+	    0,
+	    0,
+	    subresourceLayer,
+	    imageOffset,
+	    imageExtent};
+
+	commandBuffer.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, region);
+}
+
+void vkx::UploadBatch::generateMipmaps(vk::Image image, std::uint32_t width, std::uint32_t height, std::uint32_t mipLevels, std::uint32_t arrayLayers) const {
+	vk::ImageMemoryBarrier barrier{
+	    {},
+	    {},
+	    {},
+	    {},
+	    VK_QUEUE_FAMILY_IGNORED,
+	    VK_QUEUE_FAMILY_IGNORED,
+	    image,
+	    {vk::ImageAspectFlagBits::eColor, 0, 1, 0, arrayLayers}};
+
+	auto mipWidth = static_cast<std::int32_t>(width);
+	auto mipHeight = static_cast<std::int32_t>(height);
+
+	for (std::uint32_t level = 1; level < mipLevels; level++) {
+		// The previous level becomes the blit source once its own write has finished.
+		barrier.subresourceRange.baseMipLevel = level - 1;
+		barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+		barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+		barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+		barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+
+		commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+
+		const auto nextWidth = std::max(mipWidth / 2, 1);
+		const auto nextHeight = std::max(mipHeight / 2, 1);
+
+		const vk::ImageBlit blit{
+		    {vk::ImageAspectFlagBits::eColor, level - 1, 0, arrayLayers},
+		    {vk::Offset3D{0, 0, 0}, vk::Offset3D{mipWidth, mipHeight, 1}},
+		    {vk::ImageAspectFlagBits::eColor, level, 0, arrayLayers},
+		    {vk::Offset3D{0, 0, 0}, vk::Offset3D{nextWidth, nextHeight, 1}}};
+
+		commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+
+		barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+		barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+		commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
+
+		mipWidth = nextWidth;
+		mipHeight = nextHeight;
+	}
+
+	barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+	barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+	barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+	barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+	barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+	commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
+}
+
+void vkx::UploadBatch::copyBuffer(vk::Buffer source, vk::Buffer destination, vk::DeviceSize size) const {
+	const vk::BufferCopy region{
+	    0,
+	    0,
+	    size};
+
+	commandBuffer.copyBuffer(source, destination, region);
+}
+
+void vkx::UploadBatch::addStagingBuffer(const vkx::Buffer& buffer) {
+	stagingBuffers.push_back(buffer);
+}
+
+void vkx::UploadBatch::submit() {
+	if (submitted) {
+		throw std::runtime_error("Upload batch was already submitted.");
+	}
+
+	if (profilerSlot != vkx::GPUProfiler::NO_SLOT) {
+		profiler->endScope(commandBuffer, profilerSlot, profilerScope);
+	}
+
+	commandBuffer.end();
+
+	const vk::SubmitInfo submitInfo{{}, {}, commandBuffer};
+
+	graphicsQueue.submit(submitInfo, fence);
+
+	submitted = true;
+}
+
+bool vkx::UploadBatch::isComplete() {
+	if (!finished && submitted && logicalDevice.getFenceStatus(fence) == vk::Result::eSuccess) {
+		finish();
+	}
+
+	return finished;
+}
+
+void vkx::UploadBatch::wait() {
+	if (!submitted) {
+		submit();
+	}
+
+	if (!finished) {
+		static_cast<void>(logicalDevice.waitForFences(fence, true, UINT64_MAX));
+		finish();
+	}
+}
+
+void vkx::UploadBatch::destroy() {
+	if (submitted) {
+		wait();
+	}
+
+	// Batches destroyed without being submitted still hold their slot.
+	releaseProfilerSlot();
+
+	for (const auto& buffer : stagingBuffers) {
+		buffer.destroy();
+	}
+	stagingBuffers.clear();
+
+	logicalDevice.freeCommandBuffers(commandPool, commandBuffer);
+	logicalDevice.destroyFence(fence);
+}
+
+void vkx::UploadBatch::finish() {
+	finished = true;
+
+	for (const auto& buffer : stagingBuffers) {
+		buffer.destroy();
+	}
+	stagingBuffers.clear();
+
+	releaseProfilerSlot();
+}
+
+void vkx::UploadBatch::releaseProfilerSlot() {
+	if (profilerSlot != vkx::GPUProfiler::NO_SLOT) {
+		profiler->releaseUploadSlot(profilerSlot, submitted);
+		profilerSlot = vkx::GPUProfiler::NO_SLOT;
+	}
+}
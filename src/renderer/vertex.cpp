@@ -4,5 +4,5 @@ vkx::Vertex::Vertex(const glm::vec2& pos)
     : pos(pos) {}
 
 vkx::Vertex::Vertex(const glm::vec2& pos,
-		    const glm::vec2& uv)
+		    const glm::vec3& uv)
     : pos(pos), uv(uv) {}
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <vkx/replay.hpp>
+
+static constexpr std::array<char, 4> REPLAY_MAGIC{'V', 'K', 'X', 'R'};
+
+static constexpr std::uint32_t REPLAY_VERSION = UINT32_C(2);
+
+static constexpr std::size_t EVENT_SIZE = sizeof(vkx::InputEventType) + sizeof(std::uint32_t) + sizeof(std::int32_t) * 2;
+
+template <class T>
+static void writeValue(std::ofstream& file, const T& value) {
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static T readValue(std::ifstream& file) {
+	T value{};
+	if (!file.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+		throw std::runtime_error("Unexpected end of replay file.");
+	}
+
+	return value;
+}
+
+SDL_Event vkx::InputEvent::toSDLEvent() const noexcept {
+	SDL_Event event{};
+
+	switch (type) {
+	case vkx::InputEventType::KeyDown:
+	case vkx::InputEventType::KeyUp:
+		event.type = type == vkx::InputEventType::KeyDown ? SDL_KEYDOWN : SDL_KEYUP;
+		event.key.timestamp = timestamp;
+		event.key.keysym.sym = static_cast<SDL_Keycode>(x);
+		break;
+	case vkx::InputEventType::MouseMotion:
+		event.type = SDL_MOUSEMOTION;
+		event.motion.timestamp = timestamp;
+		event.motion.x = x;
+		event.motion.y = y;
+		break;
+	case vkx::InputEventType::Quit:
+		event.type = SDL_QUIT;
+		event.quit.timestamp = timestamp;
+		break;
+	case vkx::InputEventType::MouseButtonDown:
+	case vkx::InputEventType::MouseButtonUp:
+		event.type = type == vkx::InputEventType::MouseButtonDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+		event.button.timestamp = timestamp;
+		event.button.button = static_cast<Uint8>(x);
+		event.button.state = type == vkx::InputEventType::MouseButtonDown ? SDL_PRESSED : SDL_RELEASED;
+		break;
+	}
+
+	return event;
+}
+
+vkx::InputRecorder::InputRecorder(const std::string& path)
+    : file(path, std::ios::binary | std::ios::trunc) {
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to open replay file for recording.");
+	}
+
+	file.write(REPLAY_MAGIC.data(), REPLAY_MAGIC.size());
+	writeValue(file, REPLAY_VERSION);
+}
+
+bool vkx::InputRecorder::isOpen() const {
+	return file.is_open();
+}
+
+void vkx::InputRecorder::record(const SDL_Event& event) {
+	if (!isOpen()) {
+		return;
+	}
+
+	switch (event.type) {
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+		// Held keys repeat, only the first press changes the movement state.
+		if (event.key.repeat == 0) {
+			const auto type = event.type == SDL_KEYDOWN ? vkx::InputEventType::KeyDown : vkx::InputEventType::KeyUp;
+			current.events.push_back({type, event.key.timestamp, event.key.keysym.sym, 0});
+		}
+		break;
+	case SDL_MOUSEMOTION:
+		current.events.push_back({vkx::InputEventType::MouseMotion, event.motion.timestamp, event.motion.x, event.motion.y});
+		break;
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP: {
+		const auto type = event.type == SDL_MOUSEBUTTONDOWN ? vkx::InputEventType::MouseButtonDown : vkx::InputEventType::MouseButtonUp;
+		current.events.push_back({type, event.button.timestamp, event.button.button, 0});
+		break;
+	}
+	case SDL_QUIT:
+		current.events.push_back({vkx::InputEventType::Quit, event.quit.timestamp, 0, 0});
+		break;
+	default:
+		break;
+	}
+}
+
+void vkx::InputRecorder::endFrame(const glm::vec2& cameraPosition, const glm::vec2& direction) {
+	if (!isOpen()) {
+		return;
+	}
+
+	current.cameraPosition = cameraPosition;
+	current.direction = direction;
+	ended = true;
+}
+
+void vkx::InputRecorder::publishFrame(std::uint32_t previousTicks) {
+	if (!isOpen()) {
+		return;
+	}
+
+	finish(previousTicks);
+
+	if (ended) {
+		published = std::exchange(current, vkx::InputFrame{});
+		hasPublished = true;
+		ended = false;
+	}
+}
+
+void vkx::InputRecorder::finish(std::uint32_t ticks) {
+	if (!isOpen() || !hasPublished) {
+		return;
+	}
+
+	published.ticks = ticks;
+	write(published);
+	hasPublished = false;
+}
+
+void vkx::InputRecorder::write(const vkx::InputFrame& frame) {
+	writeValue(file, static_cast<std::uint32_t>(frame.events.size()));
+	writeValue(file, frame.cameraPosition.x);
+	writeValue(file, frame.cameraPosition.y);
+	writeValue(file, frame.direction.x);
+	writeValue(file, frame.direction.y);
+	writeValue(file, frame.ticks);
+
+	for (const auto& event : frame.events) {
+		writeValue(file, event.type);
+		writeValue(file, event.timestamp);
+		writeValue(file, event.x);
+		writeValue(file, event.y);
+	}
+}
+
+vkx::InputReplayer::InputReplayer(const std::string& path) {
+	std::ifstream file{path, std::ios::binary | std::ios::ate};
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to open replay file.");
+	}
+
+	const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+	file.seekg(0);
+
+	const auto magic = readValue<std::array<char, 4>>(file);
+	if (magic != REPLAY_MAGIC || readValue<std::uint32_t>(file) != REPLAY_VERSION) {
+		throw std::runtime_error("Unsupported replay file.");
+	}
+
+	while (file.peek() != std::ifstream::traits_type::eof()) {
+		auto& frame = frames.emplace_back();
+
+		const auto eventCount = readValue<std::uint32_t>(file);
+		frame.cameraPosition.x = readValue<float>(file);
+		frame.cameraPosition.y = readValue<float>(file);
+		frame.direction.x = readValue<float>(file);
+		frame.direction.y = readValue<float>(file);
+		frame.ticks = readValue<std::uint32_t>(file);
+
+		// Counts are checked against what is left of the file before anything is allocated for them.
+		const auto remaining = fileSize - static_cast<std::uint64_t>(file.tellg());
+		if (eventCount > remaining / EVENT_SIZE) {
+			throw std::runtime_error("Corrupt replay file.");
+		}
+
+		frame.events.reserve(eventCount);
+		for (std::uint32_t i = 0; i < eventCount; i++) {
+			auto& event = frame.events.emplace_back();
+			event.type = readValue<vkx::InputEventType>(file);
+			event.timestamp = readValue<std::uint32_t>(file);
+			event.x = readValue<std::int32_t>(file);
+			event.y = readValue<std::int32_t>(file);
+		}
+	}
+
+	if (frames.empty()) {
+		throw std::runtime_error("Replay file holds no frames.");
+	}
+}
+
+bool vkx::InputReplayer::isOpen() const noexcept {
+	return !frames.empty();
+}
+
+const vkx::InputFrame* vkx::InputReplayer::next() noexcept {
+	if (nextFrame >= frames.size()) {
+		return nullptr;
+	}
+
+	return &frames[nextFrame++];
+}
+
+std::size_t vkx::InputReplayer::size() const noexcept {
+	return frames.size();
+}
@@ -0,0 +1,138 @@
+#include <vkx/statistics.hpp>
+
+template <class T>
+static vkx::Percentiles percentiles(std::vector<T> values) {
+	if (values.empty()) {
+		return {};
+	}
+
+	std::sort(values.begin(), values.end());
+
+	// Nearest rank, so every percentile is a value that was actually measured.
+	const auto rank = [&values](double percentile) {
+		const auto index = static_cast<std::size_t>(glm::ceil(percentile * static_cast<double>(values.size()))) - 1;
+		return static_cast<double>(values[std::min(index, values.size() - 1)]);
+	};
+
+	return {rank(0.50), rank(0.95), rank(0.99)};
+}
+
+template <class Member>
+static auto collect(const std::vector<vkx::FrameSample>& samples, Member member) {
+	std::vector<std::decay_t<decltype(samples.front().*member)>> values{};
+	values.reserve(samples.size());
+	for (const auto& sample : samples) {
+		values.push_back(sample.*member);
+	}
+
+	return values;
+}
+
+static void writePercentiles(std::ofstream& file, const char* name, const vkx::Percentiles& percentiles, bool last = false) {
+	file << "\t\"" << name << "\": {\"p50\": " << percentiles.p50 << ", \"p95\": " << percentiles.p95 << ", \"p99\": " << percentiles.p99 << (last ? "}\n" : "},\n");
+}
+
+// Parses a single number following `"key":` inside the given object of a summary file.
+static double readNumber(const std::string& contents, const std::string& object, const std::string& key) {
+	auto position = contents.find("\"" + object + "\"");
+	if (position == std::string::npos) {
+		throw std::runtime_error("Missing " + object + " in frame summary.");
+	}
+
+	if (!key.empty()) {
+		position = contents.find("\"" + key + "\"", position);
+		if (position == std::string::npos) {
+			throw std::runtime_error("Missing " + object + "." + key + " in frame summary.");
+		}
+	}
+
+	position = contents.find(':', position);
+	if (position == std::string::npos) {
+		throw std::runtime_error("Malformed frame summary.");
+	}
+
+	return std::stod(contents.substr(position + 1));
+}
+
+static vkx::Percentiles readPercentiles(const std::string& contents, const std::string& object) {
+	return {readNumber(contents, object, "p50"),
+		readNumber(contents, object, "p95"),
+		readNumber(contents, object, "p99")};
+}
+
+static void compare(std::vector<std::string>& regressions, const char* name, const vkx::Percentiles& baseline, const vkx::Percentiles& current, double threshold) {
+	const std::array<std::pair<const char*, std::pair<double, double>>, 3> values{{
+	    {"p50", {baseline.p50, current.p50}},
+	    {"p95", {baseline.p95, current.p95}},
+	    {"p99", {baseline.p99, current.p99}},
+	}};
+
+	for (const auto& [percentile, value] : values) {
+		const auto [before, after] = value;
+		if (after > before * (1.0 + threshold) && after - before > std::numeric_limits<float>::epsilon()) {
+			std::ostringstream message{};
+			message << name << ' ' << percentile << " regressed from " << before << " to " << after;
+			regressions.push_back(message.str());
+		}
+	}
+}
+
+void vkx::FrameStatistics::add(const vkx::FrameSample& sample) {
+	samples.push_back(sample);
+}
+
+std::size_t vkx::FrameStatistics::size() const noexcept {
+	return samples.size();
+}
+
+vkx::FrameSummary vkx::FrameStatistics::summarize() const {
+	return {samples.size(),
+		percentiles(collect(samples, &vkx::FrameSample::cpuMilliseconds)),
+		percentiles(collect(samples, &vkx::FrameSample::gpuMilliseconds)),
+		percentiles(collect(samples, &vkx::FrameSample::chunksGenerated)),
+		percentiles(collect(samples, &vkx::FrameSample::bytesUploaded))};
+}
+
+bool vkx::writeSummary(const std::string& file, const vkx::FrameSummary& summary) {
+	std::ofstream output{file, std::ios::trunc};
+	if (!output.is_open()) {
+		return false;
+	}
+
+	output << std::setprecision(9);
+	output << "{\n";
+	output << "\t\"frames\": " << summary.frames << ",\n";
+	writePercentiles(output, "cpu_ms", summary.cpuMilliseconds);
+	writePercentiles(output, "gpu_ms", summary.gpuMilliseconds);
+	writePercentiles(output, "chunks_generated", summary.chunksGenerated);
+	writePercentiles(output, "bytes_uploaded", summary.bytesUploaded, true);
+	output << "}\n";
+
+	return output.good();
+}
+
+vkx::FrameSummary vkx::readSummary(const std::string& file) {
+	std::ifstream input{file};
+	if (!input.is_open()) {
+		throw std::runtime_error("Failed to open frame summary " + file + ".");
+	}
+
+	const std::string contents{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+
+	return {static_cast<std::size_t>(readNumber(contents, "frames", "")),
+		readPercentiles(contents, "cpu_ms"),
+		readPercentiles(contents, "gpu_ms"),
+		readPercentiles(contents, "chunks_generated"),
+		readPercentiles(contents, "bytes_uploaded")};
+}
+
+std::vector<std::string> vkx::findRegressions(const vkx::FrameSummary& baseline, const vkx::FrameSummary& current, double threshold) {
+	std::vector<std::string> regressions{};
+
+	compare(regressions, "cpu_ms", baseline.cpuMilliseconds, current.cpuMilliseconds, threshold);
+	compare(regressions, "gpu_ms", baseline.gpuMilliseconds, current.gpuMilliseconds, threshold);
+	compare(regressions, "chunks_generated", baseline.chunksGenerated, current.chunksGenerated, threshold);
+	compare(regressions, "bytes_uploaded", baseline.bytesUploaded, current.bytesUploaded, threshold);
+
+	return regressions;
+}
@@ -0,0 +1,97 @@
+#include <vkx/thread_pool.hpp>
+
+vkx::ThreadPool::ThreadPool(std::size_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	for (std::size_t i = 1; i < threadCount; i++) {
+		workers.emplace_back(&ThreadPool::work, this);
+	}
+}
+
+vkx::ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard lock{mutex};
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+std::size_t vkx::ThreadPool::size() const noexcept {
+	return workers.size() + 1;
+}
+
+void vkx::ThreadPool::run(std::size_t count, const std::function<void(std::size_t)>& newTask) {
+	if (count == 0) {
+		return;
+	}
+
+	{
+		std::lock_guard lock{mutex};
+		task = &newTask;
+		taskCount = count;
+		nextTask.store(0, std::memory_order_relaxed);
+		busyWorkers = workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	drain();
+
+	std::unique_lock lock{mutex};
+	finished.wait(lock, [this] { return busyWorkers == 0; });
+	task = nullptr;
+
+	if (error) {
+		const auto rethrown = error;
+		error = nullptr;
+		std::rethrow_exception(rethrown);
+	}
+}
+
+void vkx::ThreadPool::work() {
+	std::uint64_t seenGeneration = 0;
+
+	while (true) {
+		{
+			std::unique_lock lock{mutex};
+			wake.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+			if (stopping) {
+				return;
+			}
+
+			seenGeneration = generation;
+		}
+
+		drain();
+
+		{
+			std::lock_guard lock{mutex};
+			busyWorkers--;
+		}
+		finished.notify_one();
+	}
+}
+
+void vkx::ThreadPool::drain() noexcept {
+	while (true) {
+		const auto i = nextTask.fetch_add(1, std::memory_order_relaxed);
+		if (i >= taskCount) {
+			return;
+		}
+
+		try {
+			(*task)(i);
+		} catch (...) {
+			std::lock_guard lock{mutex};
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	}
+}
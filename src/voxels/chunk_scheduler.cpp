@@ -0,0 +1,102 @@
+#include <vkx/voxels/chunk_scheduler.hpp>
+#include <vkx/profiler.hpp>
+
+vkx::ChunkScheduler::ChunkScheduler(std::size_t slotCount)
+    : generations(slotCount, 0), stages(slotCount, vkx::ChunkStage::Ready) {}
+
+void vkx::ChunkScheduler::schedule(std::size_t slot) {
+	generations[slot]++;
+	stages[slot] = vkx::ChunkStage::Generate;
+	queue.push_back({slot, generations[slot], vkx::ChunkStage::Generate});
+}
+
+bool vkx::ChunkScheduler::isReady(std::size_t slot) const noexcept {
+	return stages[slot] == vkx::ChunkStage::Ready;
+}
+
+std::size_t vkx::ChunkScheduler::pendingCount() const noexcept {
+	return static_cast<std::size_t>(std::count_if(stages.begin(), stages.end(), [](auto stage) { return stage != vkx::ChunkStage::Ready; }));
+}
+
+vkx::ChunkWork vkx::ChunkScheduler::run(std::vector<vkx::VoxelChunk2D>& chunks,
+					std::vector<vkx::Mesh>& meshes,
+					vkx::ResidencyManager& residency,
+					const std::vector<std::size_t>& visibleSlots,
+					const glm::vec2& cameraPosition,
+					std::chrono::duration<double> budget,
+					std::size_t jobLimit) {
+	VKX_PROFILE_ZONE("chunk jobs");
+
+	vkx::ChunkWork work{};
+	if (queue.empty()) {
+		return work;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// Priorities follow the camera, so they are recomputed on every run and cancelled jobs are dropped on the way.
+	const auto cancelled = std::remove_if(queue.begin(), queue.end(), [this](const auto& job) { return job.generation != generations[job.slot]; });
+	queue.erase(cancelled, queue.end());
+
+	const auto halfChunk = static_cast<float>(vkx::CHUNK_SIZE) / 2.0f;
+	for (auto& job : queue) {
+		job.visible = std::binary_search(visibleSlots.begin(), visibleSlots.end(), job.slot);
+		job.distance = glm::distance(chunks[job.slot].globalPosition + halfChunk, cameraPosition);
+	}
+
+	// Heaps keep the greatest element in front, so the most urgent job has to compare greatest.
+	const auto lessUrgent = [](const auto& a, const auto& b) {
+		if (a.visible != b.visible) {
+			return b.visible;
+		}
+		return a.distance > b.distance;
+	};
+
+	std::make_heap(queue.begin(), queue.end(), lessUrgent);
+
+	std::size_t jobsRun = 0;
+	const auto hasBudget = [&] {
+		if (jobLimit != 0) {
+			return jobsRun < jobLimit;
+		}
+		return jobsRun == 0 || std::chrono::steady_clock::now() - start < budget;
+	};
+
+	while (!queue.empty() && hasBudget()) {
+		std::pop_heap(queue.begin(), queue.end(), lessUrgent);
+		auto job = queue.back();
+		queue.pop_back();
+
+		auto& chunk = chunks[job.slot];
+		auto& mesh = meshes[job.slot];
+
+		switch (job.stage) {
+		case vkx::ChunkStage::Generate:
+			chunk.generateTerrain();
+			work.chunksGenerated++;
+			job.stage = vkx::ChunkStage::Mesh;
+			break;
+		case vkx::ChunkStage::Mesh:
+			chunk.generateMesh(mesh);
+			job.stage = vkx::ChunkStage::Upload;
+			break;
+		case vkx::ChunkStage::Upload:
+			// The previous buffers may still be drawn by frames in flight.
+			work.bytesUploaded += residency.reupload(mesh);
+			job.stage = vkx::ChunkStage::Ready;
+			break;
+		case vkx::ChunkStage::Ready:
+			break;
+		}
+
+		stages[job.slot] = job.stage;
+		jobsRun++;
+
+		if (job.stage != vkx::ChunkStage::Ready) {
+			queue.push_back(job);
+			std::push_heap(queue.begin(), queue.end(), lessUrgent);
+		}
+	}
+
+	return work;
+}
@@ -0,0 +1,73 @@
+#include <vkx/voxels/chunk_window.hpp>
+#include <vkx/voxels/voxels.hpp>
+
+static std::int32_t wrap(std::int32_t value, std::int32_t size) noexcept {
+	const auto remainder = value % size;
+	return remainder < 0 ? remainder + size : remainder;
+}
+
+glm::ivec2 vkx::chunkCoordinate(const glm::vec2& globalPosition) noexcept {
+	return glm::ivec2{glm::floor(globalPosition / static_cast<float>(vkx::CHUNK_SIZE))};
+}
+
+vkx::ChunkWindow::ChunkWindow(std::int32_t radius, const glm::ivec2& center)
+    : radius(radius), width(radius * 2 + 1), origin(center - radius) {
+	if (radius < 1) {
+		throw std::runtime_error("Chunk window radius must be at least one.");
+	}
+
+	coordinates.resize(static_cast<std::size_t>(width * width));
+	for (std::int32_t y = origin.y; y < origin.y + width; y++) {
+		for (std::int32_t x = origin.x; x < origin.x + width; x++) {
+			const glm::ivec2 chunk{x, y};
+			coordinates[slot(chunk)] = chunk;
+		}
+	}
+}
+
+std::int32_t vkx::ChunkWindow::getRadius() const noexcept {
+	return radius;
+}
+
+std::size_t vkx::ChunkWindow::size() const noexcept {
+	return coordinates.size();
+}
+
+std::size_t vkx::ChunkWindow::slot(const glm::ivec2& chunk) const noexcept {
+	return static_cast<std::size_t>(wrap(chunk.x, width) + wrap(chunk.y, width) * width);
+}
+
+glm::ivec2 vkx::ChunkWindow::coordinate(std::size_t slot) const {
+	return coordinates[slot];
+}
+
+bool vkx::ChunkWindow::contains(const glm::ivec2& chunk) const noexcept {
+	return chunk.x >= origin.x && chunk.x < origin.x + width && chunk.y >= origin.y && chunk.y < origin.y + width;
+}
+
+void vkx::ChunkWindow::move(const glm::vec2& cameraPosition, const glm::vec2& velocity, std::vector<std::size_t>& changed) {
+	changed.clear();
+
+	const auto cameraChunk = vkx::chunkCoordinate(cameraPosition);
+	const auto lead = glm::clamp(vkx::chunkCoordinate(cameraPosition + velocity * PREFETCH_TICKS) - cameraChunk, -(radius - 1), radius - 1);
+	const auto newOrigin = cameraChunk + lead - radius;
+
+	if (newOrigin == origin) {
+		return;
+	}
+
+	origin = newOrigin;
+
+	for (std::int32_t slotY = 0; slotY < width; slotY++) {
+		for (std::int32_t slotX = 0; slotX < width; slotX++) {
+			// The one coordinate inside the window that wraps onto this slot.
+			const glm::ivec2 chunk{origin.x + wrap(slotX - origin.x, width), origin.y + wrap(slotY - origin.y, width)};
+			const auto index = static_cast<std::size_t>(slotX + slotY * width);
+
+			if (coordinates[index] != chunk) {
+				coordinates[index] = chunk;
+				changed.push_back(index);
+			}
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#include <vkx/voxels/edit_queue.hpp>
+#include <vkx/profiler.hpp>
+
+void vkx::EditQueue::push(const glm::ivec2& position, vkx::Voxel voxel) {
+	edits.push_back({position, voxel});
+}
+
+std::size_t vkx::EditQueue::size() const noexcept {
+	return edits.size();
+}
+
+void vkx::EditQueue::apply(const vkx::ChunkWindow& window, std::vector<vkx::VoxelChunk2D>& chunks, const vkx::ChunkScheduler& scheduler, std::vector<std::size_t>& touched) {
+	VKX_PROFILE_ZONE("apply edits");
+
+	touched.clear();
+
+	// Waiting edits are compacted to the front, keeping their order for the next apply.
+	auto kept = edits.begin();
+	for (const auto& edit : edits) {
+		const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{edit.position});
+		if (!window.contains(chunkPosition)) {
+			continue;
+		}
+
+		const auto slot = window.slot(chunkPosition);
+		if (!scheduler.isReady(slot)) {
+			*kept = edit;
+			kept++;
+			continue;
+		}
+
+		const auto local = glm::uvec2{edit.position - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE)};
+
+		auto& chunk = chunks[slot];
+		if (chunk.at(local.x, local.y) == edit.voxel) {
+			continue;
+		}
+
+		chunk.set(local.x, local.y, edit.voxel);
+
+		if (std::find(touched.begin(), touched.end(), slot) == touched.end()) {
+			touched.push_back(slot);
+		}
+	}
+
+	edits.erase(kept, edits.end());
+}
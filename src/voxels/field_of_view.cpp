@@ -0,0 +1,52 @@
+#include <vkx/voxels/field_of_view.hpp>
+
+bool vkx::FieldOfView::isVisible(const glm::ivec2& cell) const noexcept {
+	const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+	const auto* rows = chunkVisibility(chunkPosition);
+	if (!rows) {
+		return false;
+	}
+
+	const auto local = cell - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+	return (((*rows)[static_cast<std::size_t>(local.y)] >> local.x) & 1) != 0;
+}
+
+const std::array<std::uint32_t, vkx::CHUNK_SIZE>* vkx::FieldOfView::chunkVisibility(const glm::ivec2& chunkPosition) const noexcept {
+	const auto local = chunkPosition - minChunk;
+	if (local.x < 0 || local.x >= chunkCount.x || local.y < 0 || local.y >= chunkCount.y) {
+		return nullptr;
+	}
+
+	return &visibleRows[static_cast<std::size_t>(local.x + local.y * chunkCount.x)];
+}
+
+void vkx::FieldOfView::reset(const glm::ivec2& newOrigin, std::int32_t newRadius) {
+	if (newRadius < 0) {
+		throw std::runtime_error("Field of view radius must not be negative.");
+	}
+
+	origin = newOrigin;
+	radius = newRadius;
+	minChunk = vkx::chunkCoordinate(glm::vec2{origin - radius});
+	// The square may straddle a different amount of chunk borders along each axis.
+	chunkCount = vkx::chunkCoordinate(glm::vec2{origin + radius}) - minChunk + 1;
+
+	visibleRows.assign(static_cast<std::size_t>(chunkCount.x * chunkCount.y), std::array<std::uint32_t, vkx::CHUNK_SIZE>{});
+}
+
+void vkx::FieldOfView::reveal(const glm::ivec2& cell) noexcept {
+	const auto offset = cell - origin;
+	if (offset.x * offset.x + offset.y * offset.y > radius * radius) {
+		return;
+	}
+
+	const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{cell});
+	const auto local = cell - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+	const auto chunk = chunkPosition - minChunk;
+	visibleRows[static_cast<std::size_t>(chunk.x + chunk.y * chunkCount.x)][static_cast<std::size_t>(local.y)] |= std::uint32_t{1} << local.x;
+}
+
+std::int32_t vkx::FieldOfView::floorDivide(std::int64_t numerator, std::int64_t denominator) noexcept {
+	const auto quotient = numerator / denominator;
+	return static_cast<std::int32_t>(quotient * denominator != numerator && (numerator < 0) != (denominator < 0) ? quotient - 1 : quotient);
+}
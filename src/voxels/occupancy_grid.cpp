@@ -0,0 +1,60 @@
+#include <vkx/voxels/occupancy_grid.hpp>
+
+// Chunk rows are copied as whole words.
+static_assert(vkx::CHUNK_SIZE == 32);
+
+vkx::OccupancyGrid::OccupancyGrid(const glm::ivec2& minChunk, std::int32_t chunksWide, std::int32_t chunksHigh)
+    : origin(minChunk * static_cast<std::int32_t>(vkx::CHUNK_SIZE)),
+      width(chunksWide * static_cast<std::int32_t>(vkx::CHUNK_SIZE)),
+      height(chunksHigh * static_cast<std::int32_t>(vkx::CHUNK_SIZE)) {
+	if (chunksWide < 1 || chunksHigh < 1) {
+		throw std::runtime_error("Occupancy grid must cover at least one chunk.");
+	}
+
+	// Bit indices are computed in floats, which are exact up to 2^24.
+	if (static_cast<std::int64_t>(width) * height > (std::int64_t{1} << 24)) {
+		throw std::runtime_error("Occupancy grid is too large.");
+	}
+
+	bitset.resize(static_cast<std::size_t>(width / 32 * height));
+}
+
+glm::ivec2 vkx::OccupancyGrid::getOrigin() const noexcept {
+	return origin;
+}
+
+std::int32_t vkx::OccupancyGrid::getWidth() const noexcept {
+	return width;
+}
+
+std::int32_t vkx::OccupancyGrid::getHeight() const noexcept {
+	return height;
+}
+
+const std::uint32_t* vkx::OccupancyGrid::data() const noexcept {
+	return bitset.data();
+}
+
+bool vkx::OccupancyGrid::isSolid(const glm::ivec2& globalPosition) const noexcept {
+	const auto local = globalPosition - origin;
+	if (local.x < 0 || local.x >= width || local.y < 0 || local.y >= height) {
+		return false;
+	}
+
+	const auto i = static_cast<std::uint32_t>(local.x + local.y * width);
+	return (bitset[i >> 5] >> (i & 31)) & 1;
+}
+
+void vkx::OccupancyGrid::copyChunk(const glm::ivec2& chunkPosition, const vkx::VoxelChunk2D& chunk) {
+	constexpr auto chunkSize = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+	const auto local = chunkPosition * chunkSize - origin;
+	if (local.x < 0 || local.x >= width || local.y < 0 || local.y >= height) {
+		return;
+	}
+
+	const auto wordsPerRow = width / 32;
+	for (std::int32_t y = 0; y < chunkSize; y++) {
+		bitset[static_cast<std::size_t>((local.y + y) * wordsPerRow + local.x / 32)] = chunk.rowOccupancy[static_cast<std::size_t>(y)];
+	}
+}
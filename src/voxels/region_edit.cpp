@@ -0,0 +1,151 @@
+#include <vkx/voxels/region_edit.hpp>
+#include <vkx/profiler.hpp>
+
+vkx::RegionEditor::RegionEditor(const vkx::ChunkWindow& window, std::vector<vkx::VoxelChunk2D>& chunks, const vkx::ChunkScheduler& scheduler, std::vector<std::size_t>& touched)
+    : window(&window), chunks(&chunks), scheduler(&scheduler), touched(&touched) {}
+
+void vkx::RegionEditor::fillSpan(std::int32_t y, std::int32_t minX, std::int32_t maxX, vkx::Voxel voxel) {
+	constexpr auto size = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+	for (auto x = minX; x < maxX;) {
+		const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{x, y});
+		const auto chunkMin = chunkPosition * size;
+		const auto end = std::min(maxX, chunkMin.x + size);
+
+		auto* chunk = readyChunk(chunkPosition);
+		if (chunk && chunk->fillRow(y - chunkMin.y, x - chunkMin.x, end - chunkMin.x, voxel)) {
+			touch(chunkPosition);
+		}
+
+		x = end;
+	}
+}
+
+void vkx::RegionEditor::fillRect(const glm::ivec2& min, const glm::ivec2& max, vkx::Voxel voxel) {
+	VKX_PROFILE_ZONE("fillRect");
+
+	for (auto y = min.y; y < max.y; y++) {
+		fillSpan(y, min.x, max.x, voxel);
+	}
+}
+
+void vkx::RegionEditor::fillCircle(const glm::ivec2& center, std::int32_t radius, vkx::Voxel voxel) {
+	VKX_PROFILE_ZONE("fillCircle");
+
+	for (auto y = -radius; y <= radius; y++) {
+		const auto halfWidth = static_cast<std::int32_t>(std::sqrt(static_cast<float>(radius * radius - y * y)));
+		fillSpan(center.y + y, center.x - halfWidth, center.x + halfWidth + 1, voxel);
+	}
+}
+
+void vkx::RegionEditor::stamp(const glm::ivec2& position, const vkx::VoxelPrefab& prefab) {
+	VKX_PROFILE_ZONE("stamp");
+
+	if (prefab.size.x < 0 || prefab.size.y < 0 || prefab.voxels.size() != static_cast<std::size_t>(prefab.size.x) * static_cast<std::size_t>(prefab.size.y)) {
+		throw std::runtime_error("Prefab voxels do not match its size.");
+	}
+
+	constexpr auto size = static_cast<std::int32_t>(vkx::CHUNK_SIZE);
+
+	for (std::int32_t row = 0; row < prefab.size.y; row++) {
+		const auto y = position.y + row;
+		const auto* source = prefab.voxels.data() + static_cast<std::size_t>(row) * static_cast<std::size_t>(prefab.size.x);
+
+		for (auto x = position.x; x < position.x + prefab.size.x;) {
+			const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{x, y});
+			const auto chunkMin = chunkPosition * size;
+			const auto end = std::min(position.x + prefab.size.x, chunkMin.x + size);
+
+			auto* chunk = readyChunk(chunkPosition);
+			if (chunk && chunk->copyRow(y - chunkMin.y, x - chunkMin.x, source + (x - position.x), end - x)) {
+				touch(chunkPosition);
+			}
+
+			x = end;
+		}
+	}
+}
+
+std::size_t vkx::RegionEditor::floodFill(const glm::ivec2& start, vkx::Voxel voxel, std::size_t limit) {
+	VKX_PROFILE_ZONE("floodFill");
+
+	const auto* startChunk = readyChunk(vkx::chunkCoordinate(glm::vec2{start}));
+	if (!startChunk) {
+		return 0;
+	}
+
+	const auto local = glm::uvec2{start - vkx::chunkCoordinate(glm::vec2{start}) * static_cast<std::int32_t>(vkx::CHUNK_SIZE)};
+	const auto target = startChunk->at(local.x, local.y);
+	if (target == voxel) {
+		return 0;
+	}
+
+	// Scanline fill, every popped seed fills the whole run of its row and seeds each run next to it in the rows above and below.
+	std::size_t filled = 0;
+	seeds.clear();
+	seeds.push_back(start);
+
+	while (!seeds.empty() && filled < limit) {
+		const auto seed = seeds.back();
+		seeds.pop_back();
+
+		if (!matches(seed, target)) {
+			continue;
+		}
+
+		auto minX = seed.x;
+		while (matches({minX - 1, seed.y}, target)) {
+			minX--;
+		}
+
+		auto maxX = seed.x + 1;
+		while (matches({maxX, seed.y}, target)) {
+			maxX++;
+		}
+
+		maxX = static_cast<std::int32_t>(std::min<std::int64_t>(maxX, minX + static_cast<std::int64_t>(limit - filled)));
+		fillSpan(seed.y, minX, maxX, voxel);
+		filled += static_cast<std::size_t>(maxX - minX);
+
+		for (const auto y : {seed.y - 1, seed.y + 1}) {
+			auto inRun = false;
+			for (auto x = minX; x < maxX; x++) {
+				const auto match = matches({x, y}, target);
+				if (match && !inRun) {
+					seeds.push_back({x, y});
+				}
+
+				inRun = match;
+			}
+		}
+	}
+
+	return filled;
+}
+
+vkx::VoxelChunk2D* vkx::RegionEditor::readyChunk(const glm::ivec2& chunk) const {
+	if (!window->contains(chunk)) {
+		return nullptr;
+	}
+
+	const auto slot = window->slot(chunk);
+	return scheduler->isReady(slot) ? &(*chunks)[slot] : nullptr;
+}
+
+bool vkx::RegionEditor::matches(const glm::ivec2& position, vkx::Voxel target) const {
+	const auto chunkPosition = vkx::chunkCoordinate(glm::vec2{position});
+	const auto* chunk = readyChunk(chunkPosition);
+	if (!chunk) {
+		return false;
+	}
+
+	const auto local = glm::uvec2{position - chunkPosition * static_cast<std::int32_t>(vkx::CHUNK_SIZE)};
+	return chunk->at(local.x, local.y) == target;
+}
+
+void vkx::RegionEditor::touch(const glm::ivec2& chunk) {
+	const auto slot = window->slot(chunk);
+	if (std::find(touched->begin(), touched->end(), slot) == touched->end()) {
+		touched->push_back(slot);
+	}
+}
@@ -0,0 +1,39 @@
+#include <vkx/asset_pack.hpp>
+
+// vkx_pack output.pack [--shader name file.spv]... [--texture name layer0 [layer1...]]...
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		SDL_Log("Usage: vkx_pack output.pack [--shader name file.spv]... [--texture name layer...]...");
+		return EXIT_FAILURE;
+	}
+
+	try {
+		vkx::AssetPackWriter writer{};
+
+		for (int i = 2; i < argc;) {
+			const std::string argument{argv[i]};
+
+			if (argument == "--shader" && i + 2 < argc) {
+				writer.addShader(argv[i + 1], argv[i + 2]);
+				i += 3;
+			} else if (argument == "--texture" && i + 2 < argc) {
+				const std::string name{argv[i + 1]};
+				std::vector<std::string> layers{};
+				for (i += 2; i < argc && std::strncmp(argv[i], "--", 2) != 0; i++) {
+					layers.emplace_back(argv[i]);
+				}
+
+				writer.addTexture(name, layers);
+			} else {
+				throw std::invalid_argument("Unknown argument: " + argument);
+			}
+		}
+
+		writer.write(argv[1]);
+	} catch (const std::exception& exception) {
+		SDL_Log("%s", exception.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}